@@ -0,0 +1,44 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/tstest/tests/main.cpp" "tstest/tests/CMakeFiles/tstest_test.dir/main.cpp.o" "gcc" "tstest/tests/CMakeFiles/tstest_test.dir/main.cpp.o.d"
+  "/root/repo/tstest/tests/test_details/test_algorithm.cpp" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_algorithm.cpp.o" "gcc" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_algorithm.cpp.o.d"
+  "/root/repo/tstest/tests/test_details/test_assertor.cpp" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_assertor.cpp.o" "gcc" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_assertor.cpp.o.d"
+  "/root/repo/tstest/tests/test_details/test_barrier.cpp" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_barrier.cpp.o" "gcc" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_barrier.cpp.o.d"
+  "/root/repo/tstest/tests/test_details/test_context.cpp" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_context.cpp.o" "gcc" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_context.cpp.o.d"
+  "/root/repo/tstest/tests/test_details/test_coverage.cpp" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_coverage.cpp.o" "gcc" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_coverage.cpp.o.d"
+  "/root/repo/tstest/tests/test_details/test_enumerator.cpp" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_enumerator.cpp.o" "gcc" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_enumerator.cpp.o.d"
+  "/root/repo/tstest/tests/test_details/test_event.cpp" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_event.cpp.o" "gcc" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_event.cpp.o.d"
+  "/root/repo/tstest/tests/test_details/test_event_buffer.cpp" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_event_buffer.cpp.o" "gcc" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_event_buffer.cpp.o.d"
+  "/root/repo/tstest/tests/test_details/test_event_index.cpp" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_event_index.cpp.o" "gcc" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_event_index.cpp.o.d"
+  "/root/repo/tstest/tests/test_details/test_event_log.cpp" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_event_log.cpp.o" "gcc" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_event_log.cpp.o.d"
+  "/root/repo/tstest/tests/test_details/test_executor.cpp" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_executor.cpp.o" "gcc" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_executor.cpp.o.d"
+  "/root/repo/tstest/tests/test_details/test_latency.cpp" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_latency.cpp.o" "gcc" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_latency.cpp.o.d"
+  "/root/repo/tstest/tests/test_details/test_matcher.cpp" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_matcher.cpp.o" "gcc" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_matcher.cpp.o.d"
+  "/root/repo/tstest/tests/test_details/test_parallel_enumerator.cpp" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_parallel_enumerator.cpp.o" "gcc" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_parallel_enumerator.cpp.o.d"
+  "/root/repo/tstest/tests/test_details/test_placement.cpp" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_placement.cpp.o" "gcc" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_placement.cpp.o.d"
+  "/root/repo/tstest/tests/test_details/test_runner.cpp" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_runner.cpp.o" "gcc" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_runner.cpp.o.d"
+  "/root/repo/tstest/tests/test_details/test_schedule_space.cpp" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_schedule_space.cpp.o" "gcc" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_schedule_space.cpp.o.d"
+  "/root/repo/tstest/tests/test_details/test_scheduler.cpp" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_scheduler.cpp.o" "gcc" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_scheduler.cpp.o.d"
+  "/root/repo/tstest/tests/test_details/test_symbol_table.cpp" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_symbol_table.cpp.o" "gcc" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_symbol_table.cpp.o.d"
+  "/root/repo/tstest/tests/test_details/test_symmetry.cpp" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_symmetry.cpp.o" "gcc" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_symmetry.cpp.o.d"
+  "/root/repo/tstest/tests/test_details/test_trace.cpp" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_trace.cpp.o" "gcc" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_trace.cpp.o.d"
+  "/root/repo/tstest/tests/test_details/test_worker_pool.cpp" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_worker_pool.cpp.o" "gcc" "tstest/tests/CMakeFiles/tstest_test.dir/test_details/test_worker_pool.cpp.o.d"
+  "/root/repo/tstest/tests/test_tstest.cpp" "tstest/tests/CMakeFiles/tstest_test.dir/test_tstest.cpp.o" "gcc" "tstest/tests/CMakeFiles/tstest_test.dir/test_tstest.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_warn_build/third_party/googletest/googletest/CMakeFiles/gtest.dir/DependInfo.cmake"
+  "/root/repo/_warn_build/third_party/googletest/googlemock/CMakeFiles/gmock.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
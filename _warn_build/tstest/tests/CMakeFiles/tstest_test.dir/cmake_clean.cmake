@@ -0,0 +1,57 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/tstest_test.dir/main.cpp.o"
+  "CMakeFiles/tstest_test.dir/main.cpp.o.d"
+  "CMakeFiles/tstest_test.dir/test_details/test_algorithm.cpp.o"
+  "CMakeFiles/tstest_test.dir/test_details/test_algorithm.cpp.o.d"
+  "CMakeFiles/tstest_test.dir/test_details/test_assertor.cpp.o"
+  "CMakeFiles/tstest_test.dir/test_details/test_assertor.cpp.o.d"
+  "CMakeFiles/tstest_test.dir/test_details/test_barrier.cpp.o"
+  "CMakeFiles/tstest_test.dir/test_details/test_barrier.cpp.o.d"
+  "CMakeFiles/tstest_test.dir/test_details/test_context.cpp.o"
+  "CMakeFiles/tstest_test.dir/test_details/test_context.cpp.o.d"
+  "CMakeFiles/tstest_test.dir/test_details/test_coverage.cpp.o"
+  "CMakeFiles/tstest_test.dir/test_details/test_coverage.cpp.o.d"
+  "CMakeFiles/tstest_test.dir/test_details/test_enumerator.cpp.o"
+  "CMakeFiles/tstest_test.dir/test_details/test_enumerator.cpp.o.d"
+  "CMakeFiles/tstest_test.dir/test_details/test_event.cpp.o"
+  "CMakeFiles/tstest_test.dir/test_details/test_event.cpp.o.d"
+  "CMakeFiles/tstest_test.dir/test_details/test_event_buffer.cpp.o"
+  "CMakeFiles/tstest_test.dir/test_details/test_event_buffer.cpp.o.d"
+  "CMakeFiles/tstest_test.dir/test_details/test_event_index.cpp.o"
+  "CMakeFiles/tstest_test.dir/test_details/test_event_index.cpp.o.d"
+  "CMakeFiles/tstest_test.dir/test_details/test_event_log.cpp.o"
+  "CMakeFiles/tstest_test.dir/test_details/test_event_log.cpp.o.d"
+  "CMakeFiles/tstest_test.dir/test_details/test_executor.cpp.o"
+  "CMakeFiles/tstest_test.dir/test_details/test_executor.cpp.o.d"
+  "CMakeFiles/tstest_test.dir/test_details/test_latency.cpp.o"
+  "CMakeFiles/tstest_test.dir/test_details/test_latency.cpp.o.d"
+  "CMakeFiles/tstest_test.dir/test_details/test_matcher.cpp.o"
+  "CMakeFiles/tstest_test.dir/test_details/test_matcher.cpp.o.d"
+  "CMakeFiles/tstest_test.dir/test_details/test_parallel_enumerator.cpp.o"
+  "CMakeFiles/tstest_test.dir/test_details/test_parallel_enumerator.cpp.o.d"
+  "CMakeFiles/tstest_test.dir/test_details/test_placement.cpp.o"
+  "CMakeFiles/tstest_test.dir/test_details/test_placement.cpp.o.d"
+  "CMakeFiles/tstest_test.dir/test_details/test_runner.cpp.o"
+  "CMakeFiles/tstest_test.dir/test_details/test_runner.cpp.o.d"
+  "CMakeFiles/tstest_test.dir/test_details/test_schedule_space.cpp.o"
+  "CMakeFiles/tstest_test.dir/test_details/test_schedule_space.cpp.o.d"
+  "CMakeFiles/tstest_test.dir/test_details/test_scheduler.cpp.o"
+  "CMakeFiles/tstest_test.dir/test_details/test_scheduler.cpp.o.d"
+  "CMakeFiles/tstest_test.dir/test_details/test_symbol_table.cpp.o"
+  "CMakeFiles/tstest_test.dir/test_details/test_symbol_table.cpp.o.d"
+  "CMakeFiles/tstest_test.dir/test_details/test_symmetry.cpp.o"
+  "CMakeFiles/tstest_test.dir/test_details/test_symmetry.cpp.o.d"
+  "CMakeFiles/tstest_test.dir/test_details/test_trace.cpp.o"
+  "CMakeFiles/tstest_test.dir/test_details/test_trace.cpp.o.d"
+  "CMakeFiles/tstest_test.dir/test_details/test_worker_pool.cpp.o"
+  "CMakeFiles/tstest_test.dir/test_details/test_worker_pool.cpp.o.d"
+  "CMakeFiles/tstest_test.dir/test_tstest.cpp.o"
+  "CMakeFiles/tstest_test.dir/test_tstest.cpp.o.d"
+  "tstest_test"
+  "tstest_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/tstest_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/tstest/tests
+# Build directory: /root/repo/_warn_build/tstest/tests
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(tstest_test "/root/repo/_warn_build/tstest/tests/tstest_test")
+set_tests_properties(tstest_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tstest/tests/CMakeLists.txt;19;add_test;/root/repo/tstest/tests/CMakeLists.txt;0;")
@@ -0,0 +1,75 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @brief EventLog Contention Benchmark
+ *
+ * Measures the per-push cost of logging operations from a growing number of
+ * threads for the SHARED and BUFFERED event log modes.
+ *
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <tstest/tstest.hpp>
+
+#include "benchmarks.hpp"
+
+using namespace tstest;
+
+namespace {
+
+const unsigned int kOperationsPerThread = 10000;
+
+/**
+ * @brief Run a scenario where each thread logs the same number of operations
+ * and return the average cost per pushed event in nanoseconds. Only the time
+ * spent inside the thread functions is measured, so thread creation and
+ * merging of buffers are excluded.
+ *
+ */
+double MeasurePushCost(EventLog::Mode mode, unsigned int num_threads) {
+  RunnerOptions options;
+  options.log_mode = mode;
+  options.buffer_capacity = 2 * kOperationsPerThread;
+  Runner runner(options);
+  std::atomic<int64_t> total_ns(0);
+
+  for (unsigned int i = 0; i < num_threads; ++i) {
+    runner["thread-" + std::to_string(i)] = [&](ExecutionContext context) {
+      auto start = BenchmarkClock::now();
+      for (unsigned int j = 0; j < kOperationsPerThread; ++j) {
+        context.LogOperationBegin("operation");
+        context.LogOperationEnd("operation");
+      }
+      auto elapsed = BenchmarkClock::now() - start;
+      total_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                      .count();
+    };
+  }
+  runner.Run();
+
+  return static_cast<double>(total_ns) /
+         (2.0 * kOperationsPerThread * num_threads);
+}
+
+}  // namespace
+
+BENCHMARK(BenchmarkEventLogContention) {
+  std::printf("%-28s %8s %16s %16s\n", "benchmark", "threads",
+              "shared ns/push", "buffered ns/push");
+  for (unsigned int num_threads : {1, 2, 4, 8, 16, 32}) {
+    double shared = MeasurePushCost(EventLog::Mode::SHARED, num_threads);
+    double buffered = MeasurePushCost(EventLog::Mode::BUFFERED, num_threads);
+    std::printf("%-28s %8u %16.1f %16.1f\n", "EventLogContention",
+                num_threads, shared, buffered);
+  }
+}
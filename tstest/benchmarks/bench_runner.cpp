@@ -0,0 +1,68 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @brief Runner Iteration Benchmark
+ *
+ * Measures the wall time of a `Runner::Run` iteration with short thread
+ * functions when spawning new threads and when reusing pooled threads.
+ *
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include <tstest/tstest.hpp>
+
+#include "benchmarks.hpp"
+
+using namespace tstest;
+
+namespace {
+
+const unsigned int kIterations = 2000;
+
+/**
+ * @brief Run a scenario repeatedly and return the average cost of an
+ * iteration in microseconds.
+ *
+ */
+double MeasureIterationCost(bool reuse_threads, unsigned int num_threads) {
+  RunnerOptions options;
+  options.log_mode = EventLog::Mode::BUFFERED;
+  options.reuse_threads = reuse_threads;
+  Runner runner(options);
+
+  for (unsigned int i = 0; i < num_threads; ++i) {
+    runner["thread-" + std::to_string(i)] = [&](ExecutionContext context) {
+      OPERATION("operation", {});
+    };
+  }
+  auto start = BenchmarkClock::now();
+  for (unsigned int i = 0; i < kIterations; ++i) {
+    runner.Run();
+  }
+  auto elapsed = BenchmarkClock::now() - start;
+
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+             .count() /
+         (1000.0 * kIterations);
+}
+
+}  // namespace
+
+BENCHMARK(BenchmarkRunnerIteration) {
+  std::printf("%-28s %8s %16s %16s\n", "benchmark", "threads",
+              "spawn us/run", "pooled us/run");
+  for (unsigned int num_threads : {1, 2, 4, 8}) {
+    double spawn = MeasureIterationCost(false, num_threads);
+    double pooled = MeasureIterationCost(true, num_threads);
+    std::printf("%-28s %8u %16.1f %16.1f\n", "RunnerIteration", num_threads,
+                spawn, pooled);
+  }
+}
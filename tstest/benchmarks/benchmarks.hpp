@@ -0,0 +1,51 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#ifndef TSTEST__BENCHMARKS__BENCHMARKS_HPP
+#define TSTEST__BENCHMARKS__BENCHMARKS_HPP
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <string>
+
+/**
+ * @brief Registry of benchmark functions keyed by name.
+ *
+ */
+inline std::map<std::string, std::function<void()>> &Benchmarks() {
+  static std::map<std::string, std::function<void()>> benchmarks;
+  return benchmarks;
+}
+
+/**
+ * @brief Helper used to register a benchmark function at static
+ * initialization.
+ *
+ */
+struct BenchmarkRegistrar {
+  BenchmarkRegistrar(const std::string &name, std::function<void()> function) {
+    Benchmarks()[name] = function;
+  }
+};
+
+/**
+ * @brief Macro used to define a benchmark.
+ *
+ */
+#define BENCHMARK(Name)                                           \
+  static void Name();                                             \
+  static BenchmarkRegistrar Name##_registrar(#Name, Name);        \
+  static void Name()
+
+/**
+ * @brief Clock used for measurements.
+ *
+ */
+typedef std::chrono::steady_clock BenchmarkClock;
+
+#endif /* TSTEST__BENCHMARKS__BENCHMARKS_HPP */
@@ -0,0 +1,23 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @brief Benchmarks
+ *
+ * Each benchmark prints one line per measured configuration. The benchmarks
+ * are registered in `benchmarks.hpp`.
+ *
+ */
+
+#include "benchmarks.hpp"
+
+int main() {
+  for (auto &benchmark : Benchmarks()) {
+    benchmark.second();
+  }
+  return 0;
+}
@@ -0,0 +1,195 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#ifndef TSTEST__DETAILS__AFFINITY_HPP
+#define TSTEST__DETAILS__AFFINITY_HPP
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * CPU affinity is only supported on Linux. On other platforms threads are not
+ * pinned and all CPUs reported by the standard library are considered
+ * available.
+ *
+ */
+#if defined(__linux__)
+#define TSTEST_HAS_AFFINITY
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace tstest {
+namespace details {
+
+/**
+ * @brief CPU identifier type
+ *
+ */
+typedef unsigned int CpuId;
+
+/**
+ * @brief Query the CPUs the calling thread is allowed to run on.
+ *
+ */
+inline std::vector<CpuId> QueryAvailableCpus() {
+  std::vector<CpuId> cpus;
+#ifdef TSTEST_HAS_AFFINITY
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+    for (CpuId cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &set)) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+#endif
+  if (cpus.empty()) {
+    CpuId count = std::max(1U, std::thread::hardware_concurrency());
+    for (CpuId cpu = 0; cpu < count; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+/**
+ * @brief Get the CPUs the process is allowed to run on. The CPUs are queried
+ * once, on first call, so that threads pinned afterwards do not restrict the
+ * result.
+ *
+ * @returns Constant reference to the identifiers of the available CPUs in
+ * increasing order
+ */
+inline const std::vector<CpuId> &GetAvailableCpus() {
+  static const std::vector<CpuId> cpus = QueryAvailableCpus();
+  return cpus;
+}
+
+/**
+ * @brief CPU Info
+ *
+ * Location of a CPU in the machine topology. CPUs with the same core are SMT
+ * siblings sharing the caches of the core, and CPUs with the same socket share
+ * the last level cache.
+ *
+ */
+struct CpuInfo {
+  /**
+   * @brief Identifier of the CPU
+   *
+   */
+  CpuId id = 0;
+  /**
+   * @brief Identifier of the physical core within the socket
+   *
+   */
+  unsigned int core = 0;
+  /**
+   * @brief Identifier of the socket
+   *
+   */
+  unsigned int socket = 0;
+  /**
+   * @brief Identifier of the NUMA node
+   *
+   */
+  unsigned int node = 0;
+};
+
+/**
+ * @brief Query the topology of the given CPUs. The topology is read from
+ * sysfs on Linux. Elsewhere, or if unreadable, each CPU is assumed to be a core
+ * of its own on socket and node zero.
+ *
+ * @param cpus Constant reference to the CPU identifiers
+ * @returns Topology of the CPUs in the given order
+ */
+inline std::vector<CpuInfo> QueryCpuTopology(const std::vector<CpuId> &cpus) {
+  std::vector<CpuInfo> topology;
+  for (auto cpu : cpus) {
+    CpuInfo info;
+    info.id = cpu;
+    info.core = cpu;
+#ifdef TSTEST_HAS_AFFINITY
+    std::string path = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+    auto read = [&path](const char *name, unsigned int &value) {
+      FILE *file = std::fopen((path + "/topology/" + name).c_str(), "r");
+      if (file == nullptr) {
+        return;
+      }
+      unsigned int read_value;
+      if (std::fscanf(file, "%u", &read_value) == 1) {
+        value = read_value;
+      }
+      std::fclose(file);
+    };
+    read("core_id", info.core);
+    read("physical_package_id", info.socket);
+    // The node is linked into the CPU directory as `node<id>`
+    DIR *directory = opendir(path.c_str());
+    if (directory != nullptr) {
+      while (dirent *entry = readdir(directory)) {
+        if (std::strncmp(entry->d_name, "node", 4) == 0 &&
+            entry->d_name[4] >= '0' && entry->d_name[4] <= '9') {
+          info.node = std::strtoul(entry->d_name + 4, nullptr, 10);
+          break;
+        }
+      }
+      closedir(directory);
+    }
+#endif
+    topology.push_back(info);
+  }
+  return topology;
+}
+
+/**
+ * @brief Get the topology of the CPUs the process is allowed to run on. The
+ * topology is queried once, on first call.
+ *
+ * @returns Constant reference to the topology in the order of
+ * `GetAvailableCpus`
+ */
+inline const std::vector<CpuInfo> &GetCpuTopology() {
+  static const std::vector<CpuInfo> topology =
+      QueryCpuTopology(GetAvailableCpus());
+  return topology;
+}
+
+/**
+ * @brief Restrict the calling thread to the given CPUs.
+ *
+ * @param cpus Constant reference to the CPU identifiers, all available CPUs
+ * if empty
+ * @returns `true` if the affinity was set else `false`
+ */
+inline bool SetThreadAffinity(const std::vector<CpuId> &cpus) {
+#ifdef TSTEST_HAS_AFFINITY
+  const std::vector<CpuId> &allowed = cpus.empty() ? GetAvailableCpus() : cpus;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (auto cpu : allowed) {
+    CPU_SET(cpu, &set);
+  }
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+  return false;
+#endif
+}
+
+}  // namespace details
+}  // namespace tstest
+
+#endif /* TSTEST__DETAILS__AFFINITY_HPP */
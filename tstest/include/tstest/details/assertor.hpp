@@ -9,12 +9,15 @@
 #define TSTEST__DETAILS__ASSERTOR_HPP
 
 #include <functional>
+#include <stdexcept>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <tstest/details/defs.hpp>
 #include <tstest/details/event_log.hpp>
 #include <tstest/details/exception.hpp>
+#include <tstest/details/symmetry.hpp>
 
 namespace tstest {
 namespace details {
@@ -75,7 +78,11 @@ class Assertor {
    * @returns Constant reference to assertion function
    */
   const AssertionFunction &Get(const EventList &event_list) const {
-    return dispatch_table.at(event_list);
+    auto it = Find(event_list);
+    if (it == dispatch_table.end()) {
+      throw std::out_of_range("No assertion function for event list");
+    }
+    return it->second;
   }
 
   /**
@@ -87,9 +94,39 @@ class Assertor {
    * @returns Constant reference to assertion function
    */
   const AssertionFunction &Get(EventList &&event_list) const {
-    return dispatch_table.at(event_list);
+    auto it = Find(event_list);
+    if (it == dispatch_table.end()) {
+      throw std::out_of_range("No assertion function for event list");
+    }
+    return it->second;
   }
 
+  /**
+   * @brief Find the dispatch table entry of an event list, using the canonical
+   * form of the event list if symmetry groups are set. The event list is only
+   * copied if it has to be canonicalized.
+   *
+   * @thread_unsafe
+   *
+   * @param event_list Constant reference to the event list
+   * @returns Iterator to the entry, or the end of the dispatch table
+   */
+  DispatchTable::const_iterator Find(const EventList &event_list) const {
+    if (symmetry.Empty()) {
+      return dispatch_table.find(event_list);
+    }
+    return dispatch_table.find(symmetry.Canonicalize(event_list));
+  }
+
+  /**
+   * @brief Get the dispatch table.
+   *
+   * @thread_unsafe
+   *
+   * @returns Constant reference to the dispatch table
+   */
+  const DispatchTable &GetDispatchTable() const { return dispatch_table; }
+
   /**
    * @brief Insert assertion function into dispatch table for given event list.
    *
@@ -100,7 +137,7 @@ class Assertor {
    */
   void Insert(const EventList &event_list,
               const AssertionFunction &assertion_function) {
-    dispatch_table[event_list] = assertion_function;
+    dispatch_table[Key(event_list)] = assertion_function;
   }
 
   /**
@@ -112,7 +149,7 @@ class Assertor {
    * @param assertion_function Rvalue reference to assertion function
    */
   void Insert(EventList &&event_list, AssertionFunction &&assertion_function) {
-    dispatch_table[event_list] = assertion_function;
+    dispatch_table[Key(event_list)] = assertion_function;
   }
 
   /**
@@ -127,7 +164,7 @@ class Assertor {
   void InsertMany(const std::vector<EventList> &event_lists,
                   const AssertionFunction &assertion_function) {
     for (auto &event_list : event_lists) {
-      dispatch_table[event_list] = assertion_function;
+      dispatch_table[Key(event_list)] = assertion_function;
     }
   }
 
@@ -143,7 +180,7 @@ class Assertor {
   void InsertMany(std::vector<EventList> &&event_lists,
                   AssertionFunction &&assertion_function) {
     for (auto &event_list : event_lists) {
-      dispatch_table[event_list] = assertion_function;
+      dispatch_table[Key(event_list)] = assertion_function;
     }
   }
 
@@ -156,7 +193,7 @@ class Assertor {
    * @returns `1` if an assertion function is removed else `0`
    */
   size_t Remove(const EventList &event_list) {
-    return dispatch_table.erase(event_list);
+    return dispatch_table.erase(Key(event_list));
   }
 
   /**
@@ -168,7 +205,7 @@ class Assertor {
    * @returns `1` if an assertion function is removed else `0`
    */
   size_t Remove(const EventList &&event_list) {
-    return dispatch_table.erase(event_list);
+    return dispatch_table.erase(Key(event_list));
   }
 
   /**
@@ -177,26 +214,20 @@ class Assertor {
    *
    * @thread_unsafe
    *
-   * @param event_log Constant reference to the event log.
+   * @param event_list Constant reference to the observed list of events.
    *
    */
-  void Assert(const EventLog &event_log) const {
-    EventList event_list = event_log.GetEvents();
-
-    AssertionFunction assertion_function = [&]() {
+  void Assert(const EventList &event_list) const {
+    // Find assertion function for given event list
+    auto it = Find(event_list);
+    // Check if assertion function found
+    if (it == dispatch_table.end()) {
       // TODO: Detailed exception message
       throw NoAssertionFunctionFound(event_list);
-    };
-
-    // Find assertion function for given event log
-    auto it = dispatch_table.find(event_list);
-    // Check if assertion function found
-    if (it != dispatch_table.end()) {
-      assertion_function = it->second;
     }
 
     // Calling assertion function
-    assertion_function();
+    it->second();
   }
 
   /**
@@ -205,31 +236,106 @@ class Assertor {
    *
    * @thread_unsafe
    *
+   * @param event_list Constant reference to the observed list of events.
+   * @param default_function Default assertion function
+   *
+   */
+  void Assert(const EventList &event_list,
+              const AssertionFunction &default_function) const {
+    // Find assertion function for given event list
+    auto it = Find(event_list);
+    // Check if assertion function found and call it
+    if (it != dispatch_table.end()) {
+      it->second();
+    } else {
+      default_function();
+    }
+  }
+
+  /**
+   * @brief Run assertion using the configured dispatch table. An exception is
+   * thrown in case no assertion function is found for the observed event logs.
+   * The events of a sealed log are used without copying.
+   *
+   * @thread_unsafe
+   *
+   * @param event_log Constant reference to the event log.
+   *
+   */
+  void Assert(const EventLog &event_log) const {
+    if (event_log.IsSealed()) {
+      Assert(event_log.View());
+    } else {
+      Assert(event_log.GetEvents());
+    }
+  }
+
+  /**
+   * @brief Run assertion using the configured dispatch table. In case no
+   * assertion function is found then the provided default is executed. The
+   * events of a sealed log are used without copying.
+   *
+   * @thread_unsafe
+   *
    * @param event_log Constant reference to the event log.
    * @param default_function Default assertion function
    *
    */
   void Assert(const EventLog &event_log,
               const AssertionFunction &default_function) const {
-    AssertionFunction assertion_function = default_function;
-
-    // Find assertion function for given event log
-    auto it = dispatch_table.find(event_log.GetEvents());
-    // Check if assertion function found
-    if (it != dispatch_table.end()) {
-      assertion_function = it->second;
+    if (event_log.IsSealed()) {
+      Assert(event_log.View(), default_function);
+    } else {
+      Assert(event_log.GetEvents(), default_function);
     }
+  }
 
-    // Calling assertion function
-    assertion_function();
+  /**
+   * @brief Set groups of interchangeable threads. Event lists which only differ
+   * by a permutation of the threads in a group are then mapped to the same
+   * assertion function. Event lists in the dispatch table are replaced by
+   * their canonical form.
+   *
+   * @thread_unsafe
+   *
+   * @param symmetry Constant reference to the symmetry groups
+   */
+  void SetSymmetry(const SymmetryGroups &symmetry) {
+    this->symmetry = symmetry;
+    DispatchTable table;
+    for (auto &element : dispatch_table) {
+      table[Key(element.first)] = std::move(element.second);
+    }
+    dispatch_table = std::move(table);
   }
 
+  /**
+   * @brief Get the groups of interchangeable threads.
+   *
+   * @thread_unsafe
+   *
+   */
+  const SymmetryGroups &GetSymmetry() const { return symmetry; }
+
   TSTEST_PRIVATE
+  /**
+   * @brief Get the dispatch table key of an event list.
+   *
+   */
+  EventList Key(const EventList &event_list) const {
+    return symmetry.Empty() ? event_list : symmetry.Canonicalize(event_list);
+  }
+
   /**
    * @brief Dispatch table mapping list of events to assertion functions.
    *
    */
   DispatchTable dispatch_table;
+  /**
+   * @brief Groups of interchangeable threads
+   *
+   */
+  SymmetryGroups symmetry;
 };
 
 }  // namespace details
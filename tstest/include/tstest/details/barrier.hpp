@@ -0,0 +1,110 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#ifndef TSTEST__DETAILS__BARRIER_HPP
+#define TSTEST__DETAILS__BARRIER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define TSTEST_CPU_PAUSE() _mm_pause()
+#else
+#define TSTEST_CPU_PAUSE()
+#endif
+
+#include <tstest/details/defs.hpp>
+
+namespace tstest {
+namespace details {
+
+/**
+ * @brief Spin Barrier Class
+ *
+ * A reusable barrier releasing a fixed number of threads together. Waiting
+ * threads spin on a generation counter so that they observe the release
+ * within a few cycles of the last arrival. After spinning for a while a
+ * waiting thread yields its processor, so that oversubscribed runs still make
+ * progress.
+ *
+ */
+class SpinBarrier {
+ public:
+  /**
+   * @brief Number of spins before a waiting thread starts yielding.
+   *
+   */
+  static constexpr unsigned int kSpinLimit = 1 << 14;
+
+  /**
+   * @brief Construct a new Spin Barrier object
+   *
+   * @param count Number of threads to release together
+   */
+  explicit SpinBarrier(size_t count = 0)
+      : count(count), waiting(0), generation(0) {}
+
+  /**
+   * @brief Set the number of threads to release together.
+   *
+   * @note Should only be called when no thread is waiting at the barrier.
+   *
+   * @param count Number of threads to release together
+   */
+  void Reset(size_t count) {
+    this->count = count;
+    waiting.store(0, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Wait until the configured number of threads arrive at the barrier.
+   *
+   * @thread_safe
+   *
+   */
+  void Wait() {
+    size_t current = generation.load(std::memory_order_acquire);
+    if (waiting.fetch_add(1, std::memory_order_acq_rel) + 1 == count) {
+      // Last arrival: rearm the barrier and release the waiting threads
+      waiting.store(0, std::memory_order_relaxed);
+      generation.fetch_add(1, std::memory_order_release);
+      return;
+    }
+    for (unsigned int spins = 0;
+         generation.load(std::memory_order_acquire) == current; ++spins) {
+      if (spins < kSpinLimit) {
+        TSTEST_CPU_PAUSE();
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  TSTEST_PRIVATE
+  /**
+   * @brief Number of threads to release together
+   *
+   */
+  size_t count;
+  /**
+   * @brief Number of threads waiting in the current generation
+   *
+   */
+  std::atomic<size_t> waiting;
+  /**
+   * @brief Number of times the barrier released its threads
+   *
+   */
+  std::atomic<size_t> generation;
+};
+
+}  // namespace details
+}  // namespace tstest
+
+#endif /* TSTEST__DETAILS__BARRIER_HPP */
@@ -0,0 +1,113 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#ifndef TSTEST__DETAILS__CLOCK_HPP
+#define TSTEST__DETAILS__CLOCK_HPP
+
+#include <chrono>
+#include <cstdint>
+
+/**
+ * Use the time stamp counter of x86 processors for timestamps when
+ * `TSTEST_CLOCK_TSC` is defined. Otherwise `std::chrono::steady_clock` is used.
+ *
+ */
+#if defined(TSTEST_CLOCK_TSC) && (defined(__x86_64__) || defined(__i386__))
+#define TSTEST_USE_TSC
+#include <x86intrin.h>
+#endif
+
+namespace tstest {
+namespace details {
+
+/**
+ * @brief Timestamp type
+ *
+ * Monotonic timestamp in clock ticks.
+ *
+ */
+typedef uint64_t Timestamp;
+
+/**
+ * @brief Clock Class
+ *
+ * Cheap monotonic clock used to timestamp events. The clock source is chosen
+ * at compile time: the time stamp counter if `TSTEST_CLOCK_TSC` is defined on
+ * x86 processors, else `std::chrono::steady_clock`.
+ *
+ */
+class Clock {
+ public:
+  /**
+   * @brief Get the current timestamp.
+   *
+   * @returns Current time in clock ticks
+   */
+  static Timestamp Now() {
+#ifdef TSTEST_USE_TSC
+    return __rdtsc();
+#else
+    return static_cast<Timestamp>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+#endif
+  }
+
+  /**
+   * @brief Get the duration of a clock tick. For the time stamp counter the
+   * duration is calibrated against `std::chrono::steady_clock` on first call.
+   *
+   * @returns Nanoseconds per clock tick
+   */
+  static double NanosecondsPerTick() {
+#ifdef TSTEST_USE_TSC
+    static const double ns_per_tick = Calibrate();
+    return ns_per_tick;
+#else
+    return 1.0;
+#endif
+  }
+
+  /**
+   * @brief Convert a number of clock ticks to nanoseconds.
+   *
+   * @param ticks Number of clock ticks
+   * @returns Number of nanoseconds
+   */
+  static double ToNanoseconds(Timestamp ticks) {
+    return static_cast<double>(ticks) * NanosecondsPerTick();
+  }
+
+ private:
+#ifdef TSTEST_USE_TSC
+  /**
+   * @brief Measure the duration of a time stamp counter tick by spinning for a
+   * few milliseconds.
+   *
+   */
+  static double Calibrate() {
+    typedef std::chrono::steady_clock SteadyClock;
+    auto start = SteadyClock::now();
+    Timestamp start_ticks = __rdtsc();
+    auto end = start;
+    while (end - start < std::chrono::milliseconds(5)) {
+      end = SteadyClock::now();
+    }
+    Timestamp end_ticks = __rdtsc();
+    double ns = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+            .count());
+    return ns / static_cast<double>(end_ticks - start_ticks);
+  }
+#endif
+};
+
+}  // namespace details
+}  // namespace tstest
+
+#endif /* TSTEST__DETAILS__CLOCK_HPP */
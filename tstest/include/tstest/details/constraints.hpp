@@ -0,0 +1,109 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#ifndef TSTEST__DETAILS__CONSTRAINTS_HPP
+#define TSTEST__DETAILS__CONSTRAINTS_HPP
+
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <tstest/details/defs.hpp>
+#include <tstest/details/event.hpp>
+#include <tstest/details/symbol_table.hpp>
+
+namespace tstest {
+namespace details {
+
+/**
+ * @brief Constraints Class
+ *
+ * Orderings across threads which are guaranteed by design, on top of the
+ * program order of each thread. A happens-before edge orders an event of one
+ * thread before an event of another, e.g. a push BEGIN before the pop END
+ * consuming it. A mutual exclusion group declares operations which never
+ * overlap across threads, e.g. the operations guarded by one lock. Schedules
+ * violating a constraint are infeasible and are not enumerated.
+ *
+ */
+class Constraints {
+ public:
+  /**
+   * @brief Edge
+   *
+   * Happens-before edge between two events of different threads.
+   *
+   */
+  struct Edge {
+    Event before;
+    Event after;
+  };
+
+  /**
+   * @brief Declare that an event happens before another. Occurrences are
+   * paired in program order: the k-th occurrence of the event after happens
+   * after the k-th occurrence of the event before, if there is one.
+   *
+   * @param before Constant reference to the event before
+   * @param after Constant reference to the event after
+   */
+  void AddHappensBefore(const Event &before, const Event &after) {
+    edges.push_back({before, after});
+  }
+
+  /**
+   * @brief Declare that the given operations are mutually exclusive, i.e. no
+   * thread begins one of them while another thread is between the BEGIN and
+   * END of one of them. An operation should belong to at most one group.
+   *
+   * @param operation_names Constant reference to the operation names
+   */
+  void AddMutualExclusion(const std::vector<OperationName> &operation_names) {
+    std::unordered_set<SymbolId> operations;
+    for (const auto &operation_name : operation_names) {
+      operations.insert(SymbolTable::Instance().Intern(operation_name));
+    }
+    groups.push_back(std::move(operations));
+  }
+
+  /**
+   * @brief Check if no constraint has been declared.
+   *
+   */
+  bool Empty() const { return edges.empty() && groups.empty(); }
+
+  /**
+   * @brief Get the happens-before edges.
+   *
+   */
+  const std::vector<Edge> &GetEdges() const { return edges; }
+
+  /**
+   * @brief Get the mutual exclusion groups as sets of operation identifiers.
+   *
+   */
+  const std::vector<std::unordered_set<SymbolId>> &GetGroups() const {
+    return groups;
+  }
+
+  TSTEST_PRIVATE
+  /**
+   * @brief Happens-before edges
+   *
+   */
+  std::vector<Edge> edges;
+  /**
+   * @brief Operation identifiers of each mutual exclusion group
+   *
+   */
+  std::vector<std::unordered_set<SymbolId>> groups;
+};
+
+}  // namespace details
+}  // namespace tstest
+
+#endif /* TSTEST__DETAILS__CONSTRAINTS_HPP */
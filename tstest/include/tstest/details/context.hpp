@@ -10,6 +10,8 @@
 
 #include <tstest/details/defs.hpp>
 #include <tstest/details/event_log.hpp>
+#include <tstest/details/exception.hpp>
+#include <tstest/details/scheduler.hpp>
 
 namespace tstest {
 namespace details {
@@ -28,9 +30,61 @@ class ExecutionContext {
    *
    * @param event_log Pointer to the event log used for logging operation events
    * @param thread_name Constant reference to thread name
+   * @param scheduler Pointer to the scheduler controlling the order of logged
+   * events, or `nullptr` if the threads run freely
+   * @param thread_index Index of the thread in the run used by the scheduler
+   * @param replica_index Index of the replica of a replicated thread function
    */
-  ExecutionContext(EventLog *event_log, const ThreadName &thread_name)
-      : event_log(event_log), thread_name(thread_name) {}
+  ExecutionContext(EventLog *event_log, const ThreadName &thread_name,
+                   Scheduler *scheduler = nullptr, size_t thread_index = 0,
+                   size_t replica_index = 0)
+      : event_log(event_log),
+        event_buffer(nullptr),
+        thread_id(SymbolTable::Instance().Intern(thread_name)),
+        scheduler(scheduler),
+        thread_index(thread_index),
+        replica_index(replica_index) {}
+
+  /**
+   * @brief Construct a new Execution Context object which logs operation
+   * events into a per-thread buffer of the event log.
+   *
+   * @param event_log Pointer to the event log used for stamping events
+   * @param event_buffer Pointer to the buffer owned by the event log
+   * @param thread_name Constant reference to thread name
+   * @param scheduler Pointer to the scheduler controlling the order of logged
+   * events, or `nullptr` if the threads run freely
+   * @param thread_index Index of the thread in the run used by the scheduler
+   * @param replica_index Index of the replica of a replicated thread function
+   */
+  ExecutionContext(EventLog *event_log, EventBuffer *event_buffer,
+                   const ThreadName &thread_name,
+                   Scheduler *scheduler = nullptr, size_t thread_index = 0,
+                   size_t replica_index = 0)
+      : event_log(event_log),
+        event_buffer(event_buffer),
+        thread_id(SymbolTable::Instance().Intern(thread_name)),
+        scheduler(scheduler),
+        thread_index(thread_index),
+        replica_index(replica_index) {}
+
+  /**
+   * @brief Log BEGIN operational event.
+   *
+   * @param operation_id Symbol identifier of an interned operation name
+   */
+  void LogOperationBegin(SymbolId operation_id) {
+    Log({thread_id, operation_id, Event::Type::BEGIN});
+  }
+
+  /**
+   * @brief Log END operational event.
+   *
+   * @param operation_id Symbol identifier of an interned operation name
+   */
+  void LogOperationEnd(SymbolId operation_id) {
+    Log({thread_id, operation_id, Event::Type::END});
+  }
 
   /**
    * @brief Log BEGIN operational event.
@@ -38,7 +92,8 @@ class ExecutionContext {
    * @param operation_name Rvalue reference to operation name
    */
   void LogOperationBegin(OperationName &&operation_name) {
-    event_log->Push({thread_name, operation_name, Event::Type::BEGIN});
+    Log({thread_id, SymbolTable::Instance().Intern(operation_name),
+         Event::Type::BEGIN});
   }
 
   /**
@@ -47,10 +102,53 @@ class ExecutionContext {
    * @param operation_name Rvalue reference to operation name
    */
   void LogOperationEnd(OperationName &&operation_name) {
-    event_log->Push({thread_name, operation_name, Event::Type::END});
+    Log({thread_id, SymbolTable::Instance().Intern(operation_name),
+         Event::Type::END});
   }
 
+  /**
+   * @brief Get the index of the replica executing a replicated thread
+   * function. The index is zero for thread functions which are not
+   * replicated.
+   *
+   * @returns Replica index
+   */
+  size_t GetReplicaIndex() const { return replica_index; }
+
   TSTEST_PRIVATE
+  /**
+   * @brief Log an event either into the buffer, if one is set, or directly
+   * into the event log. With a scheduler the event is logged once the
+   * scheduler picks it. An exception is thrown if the log is cancelled.
+   *
+   * END events are timestamped before logging synchronizes with the other
+   * threads and BEGIN events after, so that waiting for the log is not
+   * counted in the latency of the operation.
+   *
+   */
+  void Log(const Event &event) {
+    if (scheduler != nullptr) {
+      scheduler->Schedule(thread_index, event);
+    }
+    if (event_log->IsCancelled()) {
+      throw RunCancelled();
+    }
+    bool stamped = event_log->IsTimestamped();
+    bool begin = event.GetEventType() == Event::Type::BEGIN;
+    if (event_buffer != nullptr) {
+      Timestamp timestamp = stamped && !begin ? Clock::Now() : 0;
+      Sequence sequence = event_log->Stamp();
+      if (stamped && begin) {
+        timestamp = Clock::Now();
+      }
+      event_buffer->Push(sequence, event, timestamp);
+    } else if (begin) {
+      event_log->PushNow(event);
+    } else {
+      event_log->Push(event, stamped ? Clock::Now() : 0);
+    }
+  }
+
   /**
    * @brief Pointer to the event log used for logging operational events.
    *
@@ -58,10 +156,36 @@ class ExecutionContext {
   EventLog *event_log;
 
   /**
-   * @brief Name of the thread which utilizes the execution context
+   * @brief Pointer to the buffer used for logging operational events. Set to
+   * `nullptr` when events are pushed directly into the event log.
+   *
+   */
+  EventBuffer *event_buffer;
+
+  /**
+   * @brief Identifier of the thread which utilizes the execution context
+   *
+   */
+  SymbolId thread_id;
+
+  /**
+   * @brief Pointer to the scheduler controlling the order of logged events.
+   * Set to `nullptr` when the threads run freely.
+   *
+   */
+  Scheduler *scheduler;
+
+  /**
+   * @brief Index of the thread in the run
+   *
+   */
+  size_t thread_index;
+
+  /**
+   * @brief Index of the replica of a replicated thread function
    *
    */
-  ThreadName thread_name;
+  size_t replica_index;
 };
 
 }  // namespace details
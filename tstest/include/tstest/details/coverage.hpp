@@ -0,0 +1,269 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#ifndef TSTEST__DETAILS__COVERAGE_HPP
+#define TSTEST__DETAILS__COVERAGE_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <tstest/details/enumerator.hpp>
+#include <tstest/details/assertor.hpp>
+#include <tstest/details/event.hpp>
+
+namespace tstest {
+namespace details {
+
+/**
+ * @brief Coverage Options
+ *
+ * Stopping criteria used when repeating a scenario until coverage. The
+ * repetition stops as soon as any of the enabled criteria is met.
+ *
+ */
+struct CoverageOptions {
+  /**
+   * @brief Maximum number of iterations, zero for no limit.
+   *
+   */
+  size_t max_iterations = 1000;
+  /**
+   * @brief Maximum wall time spent iterating, zero for no limit.
+   *
+   */
+  std::chrono::nanoseconds time_budget = std::chrono::nanoseconds::zero();
+  /**
+   * @brief Fraction of the possible schedules to observe, zero to disable.
+   *
+   */
+  double target_coverage = 1.0;
+  /**
+   * @brief Possible schedules of the scenario. If empty, all the schedules of
+   * the events observed in the first iteration are enumerated using
+   * `GetAllSchedules`.
+   *
+   */
+  std::vector<EventList> schedules;
+};
+
+/**
+ * @brief Coverage Report
+ *
+ * Statistics of the schedules observed while repeating a scenario.
+ *
+ */
+struct CoverageReport {
+  /**
+   * @brief Reason the repetition stopped
+   *
+   */
+  enum class StopReason {
+    ITERATIONS = 0,
+    TIME_BUDGET,
+    COVERAGE,
+    ASSERTOR_COVERED
+  };
+
+  /**
+   * @brief Frequency table type
+   *
+   */
+  typedef std::unordered_map<EventList, size_t, EventListHash> FrequencyTable;
+
+  /**
+   * @brief Get the fraction of the possible schedules observed.
+   *
+   * @returns Coverage in the range [0, 1], zero if no schedule is possible
+   */
+  double Coverage() const {
+    return possible == 0 ? 0 : static_cast<double>(covered) / possible;
+  }
+
+  /**
+   * @brief Number of iterations run
+   *
+   */
+  size_t iterations = 0;
+  /**
+   * @brief Wall time spent iterating
+   *
+   */
+  std::chrono::nanoseconds elapsed = std::chrono::nanoseconds::zero();
+  /**
+   * @brief Number of possible schedules
+   *
+   */
+  size_t possible = 0;
+  /**
+   * @brief Number of distinct observed schedules among the possible ones
+   *
+   */
+  size_t covered = 0;
+  /**
+   * @brief Number of event lists in the assertor dispatch table matched by an
+   * observed schedule
+   *
+   */
+  size_t asserted = 0;
+  /**
+   * @brief Number of times each distinct schedule was observed, including
+   * schedules not among the possible ones
+   *
+   */
+  FrequencyTable frequencies;
+  /**
+   * @brief Reason the repetition stopped
+   *
+   */
+  StopReason stop_reason = StopReason::ITERATIONS;
+};
+
+/**
+ * @brief Coverage Tracker Class
+ *
+ * Records the schedules observed in the iterations of a scenario and checks
+ * the stopping criteria of the coverage options.
+ *
+ */
+class CoverageTracker {
+ public:
+  /**
+   * @brief Construct a new Coverage Tracker object
+   *
+   * @param options Constant reference to the coverage options
+   * @param assertor Pointer to the assertor whose dispatch table should be
+   * covered, or null
+   */
+  CoverageTracker(const CoverageOptions &options, const Assertor *assertor)
+      : options(options),
+        assertor(assertor),
+        start(std::chrono::steady_clock::now()) {
+    AddPossible(options.schedules);
+  }
+
+  /**
+   * @brief Record the schedule observed in an iteration.
+   *
+   * @param schedule Constant reference to the observed events
+   */
+  void Add(const EventList &schedule) {
+    if (report.iterations++ == 0 && possible.empty()) {
+      ScheduleEnumerator enumerator(schedule);
+      while (enumerator.Next()) {
+        possible.insert(enumerator.Get());
+      }
+      report.possible = possible.size();
+    }
+    auto it = report.frequencies.find(schedule);
+    if (it != report.frequencies.end()) {
+      ++it->second;
+      return;
+    }
+    report.frequencies.emplace(schedule, 1);
+    if (possible.count(schedule) > 0) {
+      ++report.covered;
+    }
+    if (assertor != nullptr) {
+      // Symmetric schedules share one entry, which is counted once
+      auto entry = assertor->Find(schedule);
+      if (entry != assertor->GetDispatchTable().end() &&
+          asserted.insert(&entry->first).second) {
+        ++report.asserted;
+      }
+    }
+  }
+
+  /**
+   * @brief Check if a stopping criterion is met. The reason is stored in the
+   * report.
+   *
+   * @returns `true` if the repetition should stop else `false`
+   */
+  bool Done() {
+    report.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start);
+    if (report.iterations == 0) {
+      return false;
+    }
+    if (options.target_coverage > 0 && report.possible > 0 &&
+        report.Coverage() >= options.target_coverage) {
+      report.stop_reason = CoverageReport::StopReason::COVERAGE;
+      return true;
+    }
+    if (assertor != nullptr && !assertor->GetDispatchTable().empty() &&
+        report.asserted == assertor->GetDispatchTable().size()) {
+      report.stop_reason = CoverageReport::StopReason::ASSERTOR_COVERED;
+      return true;
+    }
+    if (options.max_iterations > 0 &&
+        report.iterations >= options.max_iterations) {
+      report.stop_reason = CoverageReport::StopReason::ITERATIONS;
+      return true;
+    }
+    if (options.time_budget > std::chrono::nanoseconds::zero() &&
+        report.elapsed >= options.time_budget) {
+      report.stop_reason = CoverageReport::StopReason::TIME_BUDGET;
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * @brief Get the report of the recorded iterations.
+   *
+   */
+  const CoverageReport &GetReport() const { return report; }
+
+  TSTEST_PRIVATE
+  /**
+   * @brief Add possible schedules of the scenario.
+   *
+   */
+  void AddPossible(const std::vector<EventList> &schedules) {
+    possible.insert(schedules.begin(), schedules.end());
+    report.possible = possible.size();
+  }
+
+  /**
+   * @brief Stopping criteria
+   *
+   */
+  const CoverageOptions &options;
+  /**
+   * @brief Assertor whose dispatch table should be covered, or null
+   *
+   */
+  const Assertor *assertor;
+  /**
+   * @brief Time at which the tracking started
+   *
+   */
+  std::chrono::steady_clock::time_point start;
+  /**
+   * @brief Set of possible schedules
+   *
+   */
+  std::unordered_set<EventList, EventListHash> possible;
+  /**
+   * @brief Keys of the dispatch table entries matched by an observed schedule
+   *
+   */
+  std::unordered_set<const EventList *> asserted;
+  /**
+   * @brief Report of the recorded iterations
+   *
+   */
+  CoverageReport report;
+};
+
+}  // namespace details
+}  // namespace tstest
+
+#endif /* TSTEST__DETAILS__COVERAGE_HPP */
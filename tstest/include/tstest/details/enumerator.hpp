@@ -0,0 +1,717 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#ifndef TSTEST__DETAILS__ENUMERATOR_HPP
+#define TSTEST__DETAILS__ENUMERATOR_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <tstest/details/constraints.hpp>
+#include <tstest/details/defs.hpp>
+#include <tstest/details/event.hpp>
+#include <tstest/details/independence.hpp>
+#include <tstest/details/schedule_space.hpp>
+#include <tstest/details/symmetry.hpp>
+
+namespace tstest {
+namespace details {
+
+/**
+ * @brief Schedule Options
+ *
+ * Reductions applied when enumerating the schedules of a list of events.
+ *
+ */
+struct ScheduleOptions {
+  /**
+   * @brief Independent operations. If any are declared, only one schedule of
+   * each Mazurkiewicz trace is enumerated.
+   *
+   */
+  Independence independence;
+  /**
+   * @brief Groups of interchangeable threads. If any are added, only the
+   * schedules in canonical form are enumerated.
+   *
+   */
+  SymmetryGroups symmetry;
+  /**
+   * @brief Orderings guaranteed by design. If any are declared, only the
+   * schedules satisfying them are enumerated.
+   *
+   */
+  Constraints constraints;
+};
+
+/**
+ * @brief Reduction Report
+ *
+ * Size of the schedule space before and after the reductions applied by a
+ * `ScheduleEnumerator`.
+ *
+ */
+struct ReductionReport {
+  /**
+   * @brief Get the factor by which the schedule space shrank.
+   *
+   */
+  double Reduction() const {
+    return explored > 0 ? static_cast<double>(total) / explored : 0;
+  }
+
+  /**
+   * @brief Number of schedules without reduction, saturated at `UINT64_MAX`
+   *
+   */
+  uint64_t total = 0;
+  /**
+   * @brief Number of schedules enumerated
+   *
+   */
+  uint64_t explored = 0;
+  /**
+   * @brief Number of partial schedules abandoned because every thread with
+   * events left was asleep or held back by a constraint
+   *
+   */
+  uint64_t blocked = 0;
+};
+
+/**
+ * @brief Schedule Enumerator Class
+ *
+ * Lazily enumerates the schedules of a list of events, i.e. the interleavings
+ * of the per-thread event sequences, one at a time. The current schedule is
+ * kept in a buffer which is reused for the next one, so enumerating takes
+ * memory linear in the number of events however many schedules there are.
+ * Numbering the threads in the order of their first event, the schedules are
+ * enumerated in lexicographic order of their thread sequences.
+ *
+ * With independent operations declared, the enumeration is reduced to the
+ * lexicographically smallest schedule of each Mazurkiewicz trace using sleep
+ * sets: once the subtree of an event is explored, the event is put asleep in
+ * the subtrees of its siblings until an event dependent on it is scheduled.
+ *
+ * With symmetry groups declared, the enumeration is reduced to the schedules
+ * in canonical form, in which the members of each group start in canonical
+ * order. Rather than filtering, a member is not scheduled before the member
+ * preceding it in canonical order has started, which prunes the subtrees of
+ * the other permutations of the group.
+ *
+ * With constraints declared, an event is not scheduled before the events it
+ * has to happen after, nor the BEGIN of a mutually exclusive operation while
+ * another thread is inside one. Events linked by a constraint are treated as
+ * dependent. Partial schedules which cannot be completed are abandoned.
+ *
+ * @example
+ *
+ *  ScheduleEnumerator enumerator(event_list);
+ *  while (enumerator.Next()) {
+ *    Check(enumerator.Get());
+ *  }
+ *
+ */
+class ScheduleEnumerator {
+ public:
+  /**
+   * @brief Value returned when no thread can be chosen.
+   *
+   */
+  static constexpr size_t npos = SIZE_MAX;
+
+  /**
+   * @brief Construct a new Schedule Enumerator object
+   *
+   * @param event_list Constant reference to the list of events
+   * @param options Constant reference to the schedule options
+   */
+  explicit ScheduleEnumerator(const EventList &event_list,
+                              const ScheduleOptions &options = ScheduleOptions())
+      : independence(options.independence),
+        threads(SplitThreads(event_list)) {
+    length = event_list.size();
+    if (!options.constraints.Empty()) {
+      Compile(options.constraints);
+    }
+    if (!options.symmetry.Empty()) {
+      std::unordered_map<SymbolId, size_t> numbers;
+      for (size_t i = 0; i < threads.size(); ++i) {
+        numbers[threads[i].front().GetThreadId()] = i;
+      }
+      predecessors.assign(threads.size(), size_t(npos));
+      for (const auto &group : options.symmetry.GetGroups()) {
+        for (size_t i = 1; i < group.size(); ++i) {
+          auto member = numbers.find(group[i]);
+          if (member == numbers.end()) {
+            continue;
+          }
+          // A member whose predecessor has no events never starts
+          auto predecessor = numbers.find(group[i - 1]);
+          predecessors[member->second] = predecessor != numbers.end()
+                                             ? predecessor->second
+                                             : member->second;
+        }
+      }
+    }
+    choices.reserve(length);
+    schedule.reserve(length);
+    sleeping.assign((length + 1) * threads.size(), false);
+    Reset();
+  }
+
+  /**
+   * @brief Restart the enumeration from the first schedule.
+   *
+   */
+  void Reset() {
+    positions.assign(threads.size(), 0);
+    std::fill(occurred.begin(), occurred.end(), 0);
+    std::fill(holders.begin(), holders.end(), size_t(npos));
+    std::fill(depths.begin(), depths.end(), 0);
+    choices.clear();
+    schedule.clear();
+    started = false;
+    done = false;
+    seeking = false;
+    bound.clear();
+    report = ReductionReport();
+    std::vector<size_t> counts;
+    for (const auto &events : threads) {
+      counts.push_back(events.size());
+    }
+    if (!ScheduleSpace::Multinomial(counts, report.total)) {
+      report.total = UINT64_MAX;
+    }
+  }
+
+  /**
+   * @brief Restrict the enumeration to the schedules whose thread sequences
+   * lie in the given range, in lexicographic order. A bound shorter than a
+   * thread sequence stands for its extensions, so that the range from a
+   * prefix to the prefix with its last thread incremented holds the schedules
+   * starting with the prefix. Used to shard the enumeration, e.g. by the
+   * ranks of a `ScheduleSpace`. The next call to `Next` advances to the first
+   * schedule of the range.
+   *
+   * @param first Constant reference to the inclusive lower bound
+   * @param last Constant reference to the exclusive upper bound, none if empty
+   */
+  void Seek(const std::vector<size_t> &first,
+            const std::vector<size_t> &last = std::vector<size_t>()) {
+    Reset();
+    started = true;
+    seeking = true;
+    bound = last;
+    // Follow the lower bound as far as possible
+    seek_backtrack = false;
+    for (auto thread : first) {
+      if (thread < threads.size() && IsEnabled(thread)) {
+        Push(thread);
+        continue;
+      }
+      // Continue with the next greater choice or backtrack if there is none
+      size_t next = thread < threads.size() ? NextEnabled(thread + 1) : npos;
+      if (next != npos) {
+        Push(next);
+      } else {
+        seek_backtrack = true;
+      }
+      break;
+    }
+  }
+
+  /**
+   * @brief Advance to the next schedule. The first call advances to the first
+   * schedule.
+   *
+   * @returns `true` if there is a next schedule else `false`
+   */
+  bool Next() {
+    if (done) {
+      return false;
+    }
+    bool advance = started;
+    started = true;
+    if (seeking) {
+      seeking = false;
+      advance = seek_backtrack;
+    }
+    if (!advance && Descend()) {
+      return Yield();
+    }
+    // Backtrack to the deepest choice which has an alternative
+    while (!choices.empty()) {
+      size_t thread = Pop();
+      size_t next = NextEnabled(thread + 1);
+      if (next != npos) {
+        Push(next);
+        if (Descend()) {
+          return Yield();
+        }
+      }
+    }
+    done = true;
+    return false;
+  }
+
+  /**
+   * @brief Get the current schedule. The reference stays valid, but its
+   * contents change when advancing.
+   *
+   * @returns Constant reference to the schedule
+   */
+  const EventList &Get() const { return schedule; }
+
+  /**
+   * @brief Get the thread number of each event of the current schedule.
+   *
+   */
+  const std::vector<size_t> &GetThreads() const { return choices; }
+
+  /**
+   * @brief Get the number of threads.
+   *
+   */
+  size_t GetThreadCount() const { return threads.size(); }
+
+  /**
+   * @brief Get the size of the schedule space before and after reduction.
+   * The number of explored schedules counts the schedules enumerated so far.
+   *
+   */
+  const ReductionReport &GetReport() const { return report; }
+
+  /**
+   * @brief Iterator Class
+   *
+   * Input iterator over the schedules of an enumerator. All iterators of an
+   * enumerator share its buffer, so only one pass is possible.
+   *
+   */
+  class Iterator {
+   public:
+    typedef std::input_iterator_tag iterator_category;
+    typedef EventList value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const EventList *pointer;
+    typedef const EventList &reference;
+
+    explicit Iterator(ScheduleEnumerator *enumerator = nullptr)
+        : enumerator(enumerator) {}
+
+    reference operator*() const { return enumerator->Get(); }
+    pointer operator->() const { return &enumerator->Get(); }
+    Iterator &operator++() {
+      if (!enumerator->Next()) {
+        enumerator = nullptr;
+      }
+      return *this;
+    }
+    bool operator==(const Iterator &other) const {
+      return enumerator == other.enumerator;
+    }
+    bool operator!=(const Iterator &other) const {
+      return enumerator != other.enumerator;
+    }
+
+   private:
+    ScheduleEnumerator *enumerator;
+  };
+
+  /**
+   * @brief Restart the enumeration and get an iterator to the first schedule.
+   *
+   */
+  Iterator begin() {
+    Reset();
+    return Next() ? Iterator(this) : Iterator();
+  }
+
+  /**
+   * @brief Get the iterator past the last schedule.
+   *
+   */
+  Iterator end() { return Iterator(); }
+
+  TSTEST_PRIVATE
+  /**
+   * @brief Constraints on an event
+   *
+   */
+  struct EventConstraints {
+    /**
+     * @brief Happens-before edges whose event before this is
+     *
+     */
+    std::vector<size_t> signals;
+    /**
+     * @brief Happens-before edges this event waits for, paired with the
+     * number of occurrences of their event before needed
+     *
+     */
+    std::vector<std::pair<size_t, size_t>> waits;
+    /**
+     * @brief Mutual exclusion group of the operation, `npos` if none
+     *
+     */
+    size_t group = npos;
+  };
+
+  /**
+   * @brief Attach the constraints to the events of the threads.
+   *
+   */
+  void Compile(const Constraints &constraints) {
+    const auto &edges = constraints.GetEdges();
+    const auto &groups = constraints.GetGroups();
+    events.resize(threads.size());
+    std::vector<size_t> totals(edges.size(), 0);
+    for (size_t thread = 0; thread < threads.size(); ++thread) {
+      events[thread].resize(threads[thread].size());
+      for (size_t i = 0; i < threads[thread].size(); ++i) {
+        const Event &event = threads[thread][i];
+        for (size_t edge = 0; edge < edges.size(); ++edge) {
+          if (edges[edge].before == event) {
+            events[thread][i].signals.push_back(edge);
+            ++totals[edge];
+          }
+        }
+        for (size_t group = 0; group < groups.size(); ++group) {
+          if (groups[group].count(event.GetOperationId()) > 0) {
+            events[thread][i].group = group;
+          }
+        }
+      }
+    }
+    // Pair the occurrences of the events after with those of the events before
+    for (size_t thread = 0; thread < threads.size(); ++thread) {
+      std::vector<size_t> seen(edges.size(), 0);
+      for (size_t i = 0; i < threads[thread].size(); ++i) {
+        for (size_t edge = 0; edge < edges.size(); ++edge) {
+          if (edges[edge].after == threads[thread][i] &&
+              ++seen[edge] <= totals[edge]) {
+            events[thread][i].waits.emplace_back(edge, seen[edge]);
+          }
+        }
+      }
+    }
+    occurred.assign(edges.size(), 0);
+    holders.assign(groups.size(), size_t(npos));
+    depths.assign(groups.size(), 0);
+  }
+
+  /**
+   * @brief Check if a thread can be scheduled next, i.e. it has an event left
+   * which is neither asleep nor held back.
+   *
+   */
+  bool IsEnabled(size_t thread) const {
+    return positions[thread] < threads[thread].size() &&
+           !sleeping[choices.size() * threads.size() + thread] &&
+           IsAllowed(thread);
+  }
+
+  /**
+   * @brief Check if the next event of a thread, which has one, is neither
+   * pruned by symmetry nor held back by a constraint.
+   *
+   */
+  bool IsAllowed(size_t thread) const {
+    if (IsPruned(thread)) {
+      return false;
+    }
+    if (events.empty()) {
+      return true;
+    }
+    const EventConstraints &constraints = events[thread][positions[thread]];
+    for (const auto &wait : constraints.waits) {
+      if (occurred[wait.first] < wait.second) {
+        return false;
+      }
+    }
+    size_t group = constraints.group;
+    return group == npos ||
+           threads[thread][positions[thread]].GetEventType() !=
+               Event::Type::BEGIN ||
+           holders[group] == npos || holders[group] == thread;
+  }
+
+  /**
+   * @brief Check if a thread cannot start yet because the member preceding it
+   * in its symmetry group has not started.
+   *
+   */
+  bool IsPruned(size_t thread) const {
+    if (predecessors.empty() || positions[thread] > 0) {
+      return false;
+    }
+    size_t predecessor = predecessors[thread];
+    return predecessor != npos && positions[predecessor] == 0;
+  }
+
+  /**
+   * @brief Get the first thread, from the given one on, which can be
+   * scheduled next.
+   *
+   */
+  size_t NextEnabled(size_t first) const {
+    for (size_t thread = first; thread < threads.size(); ++thread) {
+      if (IsEnabled(thread)) {
+        return thread;
+      }
+    }
+    return npos;
+  }
+
+  /**
+   * @brief Check if the next events of two threads, which have one, are
+   * independent and not linked by a constraint.
+   *
+   */
+  bool IsIndependent(size_t a, size_t b) const {
+    if (!independence.IsIndependent(threads[a][positions[a]],
+                                    threads[b][positions[b]])) {
+      return false;
+    }
+    if (events.empty()) {
+      return true;
+    }
+    const EventConstraints &event_a = events[a][positions[a]];
+    const EventConstraints &event_b = events[b][positions[b]];
+    if (event_a.group != npos && event_a.group == event_b.group) {
+      return false;
+    }
+    for (const auto &wait : event_a.waits) {
+      if (std::count(event_b.signals.begin(), event_b.signals.end(),
+                     wait.first) > 0) {
+        return false;
+      }
+    }
+    for (const auto &wait : event_b.waits) {
+      if (std::count(event_a.signals.begin(), event_a.signals.end(),
+                     wait.first) > 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Report the complete schedule unless it lies past the upper bound
+   * of the range.
+   *
+   * @returns `true` if the schedule is reported else `false`
+   */
+  bool Yield() {
+    if (!bound.empty() &&
+        !std::lexicographical_compare(choices.begin(), choices.end(),
+                                      bound.begin(), bound.end())) {
+      // Extensions of the end bound are past the end too
+      done = true;
+      return false;
+    }
+    ++report.explored;
+    return true;
+  }
+
+  /**
+   * @brief Extend the schedule with the first enabled threads until complete.
+   *
+   * @returns `true` if the schedule is complete else `false`
+   */
+  bool Descend() {
+    while (choices.size() < length) {
+      size_t thread = NextEnabled(0);
+      if (thread == npos) {
+        ++report.blocked;
+        return false;
+      }
+      Push(thread);
+    }
+    return true;
+  }
+
+  /**
+   * @brief Append the next event of a thread to the schedule.
+   *
+   */
+  void Push(size_t thread) {
+    if (!independence.Empty()) {
+      // The sleeping events and the events explored before at this depth stay
+      // asleep below the pushed event if independent of it. Events pruned by
+      // symmetry or held back by a constraint were not explored and stay
+      // awake.
+      size_t count = threads.size();
+      size_t depth = choices.size();
+      for (size_t other = 0; other < count; ++other) {
+        bool asleep = false;
+        if (other != thread && positions[other] < threads[other].size() &&
+            (sleeping[depth * count + other] ||
+             (other < thread && IsAllowed(other)))) {
+          asleep = IsIndependent(other, thread);
+        }
+        sleeping[(depth + 1) * count + other] = asleep;
+      }
+    }
+    if (!events.empty()) {
+      const EventConstraints &constraints = events[thread][positions[thread]];
+      for (auto edge : constraints.signals) {
+        ++occurred[edge];
+      }
+      size_t group = constraints.group;
+      if (group != npos) {
+        if (threads[thread][positions[thread]].GetEventType() ==
+            Event::Type::BEGIN) {
+          holders[group] = thread;
+          ++depths[group];
+        } else if (--depths[group] == 0) {
+          holders[group] = npos;
+        }
+      }
+    }
+    choices.push_back(thread);
+    schedule.push_back(threads[thread][positions[thread]++]);
+  }
+
+  /**
+   * @brief Remove the last event from the schedule.
+   *
+   * @returns Thread number of the removed event
+   */
+  size_t Pop() {
+    size_t thread = choices.back();
+    choices.pop_back();
+    schedule.pop_back();
+    --positions[thread];
+    if (!events.empty()) {
+      const EventConstraints &constraints = events[thread][positions[thread]];
+      for (auto edge : constraints.signals) {
+        --occurred[edge];
+      }
+      size_t group = constraints.group;
+      if (group != npos) {
+        if (threads[thread][positions[thread]].GetEventType() ==
+            Event::Type::BEGIN) {
+          if (--depths[group] == 0) {
+            holders[group] = npos;
+          }
+        } else {
+          holders[group] = thread;
+          ++depths[group];
+        }
+      }
+    }
+    return thread;
+  }
+
+  /**
+   * @brief Independent operations
+   *
+   */
+  Independence independence;
+  /**
+   * @brief Events of each thread in order
+   *
+   */
+  std::vector<std::vector<Event>> threads;
+  /**
+   * @brief Thread number of the member preceding each thread in its symmetry
+   * group, `npos` if none, empty without symmetry groups
+   *
+   */
+  std::vector<size_t> predecessors;
+  /**
+   * @brief Constraints on each event of each thread, empty without
+   * constraints
+   *
+   */
+  std::vector<std::vector<EventConstraints>> events;
+  /**
+   * @brief Number of occurrences of the event before of each happens-before
+   * edge in the current schedule
+   *
+   */
+  std::vector<size_t> occurred;
+  /**
+   * @brief Thread inside each mutual exclusion group, `npos` if none
+   *
+   */
+  std::vector<size_t> holders;
+  /**
+   * @brief Number of operations of each mutual exclusion group open in its
+   * holder
+   *
+   */
+  std::vector<size_t> depths;
+  /**
+   * @brief Number of events in a schedule
+   *
+   */
+  size_t length;
+  /**
+   * @brief Number of events of each thread in the current schedule
+   *
+   */
+  std::vector<size_t> positions;
+  /**
+   * @brief Thread number of each event in the current schedule
+   *
+   */
+  std::vector<size_t> choices;
+  /**
+   * @brief Current schedule
+   *
+   */
+  EventList schedule;
+  /**
+   * @brief Flags indicating the sleeping threads at each depth, one row of
+   * flags per depth
+   *
+   */
+  std::vector<bool> sleeping;
+  /**
+   * @brief Size of the schedule space
+   *
+   */
+  ReductionReport report;
+  /**
+   * @brief Exclusive upper bound of the thread sequences, none if empty
+   *
+   */
+  std::vector<size_t> bound;
+  /**
+   * @brief Flag indicating that `Seek` positioned the enumeration
+   *
+   */
+  bool seeking;
+  /**
+   * @brief Flag indicating that the position reached by `Seek` has to be
+   * advanced by backtracking
+   *
+   */
+  bool seek_backtrack;
+  /**
+   * @brief Flag indicating that the first schedule was visited
+   *
+   */
+  bool started;
+  /**
+   * @brief Flag indicating that all schedules were visited
+   *
+   */
+  bool done;
+};
+
+}  // namespace details
+}  // namespace tstest
+
+#endif /* TSTEST__DETAILS__ENUMERATOR_HPP */
@@ -8,9 +8,17 @@
 #ifndef TSTEST__DETAILS__EVENT_HPP
 #define TSTEST__DETAILS__EVENT_HPP
 
-#include <list>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <vector>
 
+#include <tstest/details/clock.hpp>
 #include <tstest/details/defs.hpp>
+#include <tstest/details/symbol_table.hpp>
 
 namespace tstest {
 namespace details {
@@ -25,6 +33,10 @@ namespace details {
  * - BEGIN
  * - END
  *
+ * The thread and operation names are interned in the `SymbolTable` and the
+ * event only stores their identifiers. This makes the event a small trivially
+ * copyable value which can be logged without any memory allocation.
+ *
  */
 class Event {
  public:
@@ -32,7 +44,25 @@ class Event {
    * @brief Enumerated list of event types.
    *
    */
-  enum class Type { BEGIN = 0, END };
+  enum class Type : uint8_t { BEGIN = 0, END };
+
+  /**
+   * @brief Construct a new Event object
+   *
+   */
+  Event() = default;
+
+  /**
+   * @brief Construct a new Event object
+   *
+   * @param thread_id Symbol identifier of the thread name
+   * @param operation_id Symbol identifier of the operation name
+   * @param event_type Type of event
+   */
+  Event(SymbolId thread_id, SymbolId operation_id, const Type event_type)
+      : thread_id(thread_id),
+        operation_id(operation_id),
+        event_type(event_type) {}
 
   /**
    * @brief Construct a new Event object
@@ -43,8 +73,8 @@ class Event {
    */
   Event(const ThreadName &thread_name, const OperationName &operation_name,
         const Type event_type)
-      : thread_name(thread_name),
-        operation_name(operation_name),
+      : thread_id(SymbolTable::Instance().Intern(thread_name)),
+        operation_id(SymbolTable::Instance().Intern(operation_name)),
         event_type(event_type) {}
 
   /**
@@ -56,8 +86,8 @@ class Event {
    */
   Event(ThreadName &&thread_name, OperationName &&operation_name,
         const Type event_type)
-      : thread_name(thread_name),
-        operation_name(operation_name),
+      : thread_id(SymbolTable::Instance().Intern(thread_name)),
+        operation_id(SymbolTable::Instance().Intern(operation_name)),
         event_type(event_type) {}
 
   /**
@@ -67,19 +97,37 @@ class Event {
    */
   const Type &GetEventType() const { return event_type; }
 
+  /**
+   * @brief Get the operation identifier
+   *
+   * @returns Symbol identifier of the operation name
+   */
+  SymbolId GetOperationId() const { return operation_id; }
+
+  /**
+   * @brief Get the thread identifier
+   *
+   * @returns Symbol identifier of the thread name
+   */
+  SymbolId GetThreadId() const { return thread_id; }
+
   /**
    * @brief Get the operation name
    *
-   * @returns Constant reference to the operation name
+   * @returns Constant reference to the interned operation name
    */
-  const OperationName &GetOperationName() const { return operation_name; }
+  const OperationName &GetOperationName() const {
+    return SymbolTable::Instance().Resolve(operation_id);
+  }
 
   /**
    * @brief Get the thread name
    *
-   * @returns Constant reference to the thread name
+   * @returns Constant reference to the interned thread name
    */
-  const OperationName &GetThreadName() const { return thread_name; }
+  const ThreadName &GetThreadName() const {
+    return SymbolTable::Instance().Resolve(thread_id);
+  }
 
   /**
    * @brief String representation of the event
@@ -88,7 +136,7 @@ class Event {
    */
   std::string ToString() const {
     const char *type_str[] = {"BEGIN", "END"};
-    return "{\"" + thread_name + "\", \"" + operation_name +
+    return "{\"" + GetThreadName() + "\", \"" + GetOperationName() +
            "\", tstest::Event::Type::" + type_str[(int)event_type] + "}";
   }
 
@@ -98,8 +146,7 @@ class Event {
    */
   bool operator==(const Event &other) const {
     return event_type == other.event_type &&
-           operation_name == other.operation_name &&
-           thread_name == other.thread_name;
+           operation_id == other.operation_id && thread_id == other.thread_id;
   }
 
   /**
@@ -108,28 +155,30 @@ class Event {
    */
   bool operator!=(const Event &other) const {
     return event_type != other.event_type ||
-           operation_name != other.operation_name ||
-           thread_name != other.thread_name;
+           operation_id != other.operation_id || thread_id != other.thread_id;
   }
 
   TSTEST_PRIVATE
   /**
-   * @brief Type of event
+   * @brief Identifier of the thread name
    *
    */
-  Type event_type;
+  SymbolId thread_id;
   /**
-   * @brief Name of the operation
+   * @brief Identifier of the operation name
    *
    */
-  OperationName operation_name;
+  SymbolId operation_id;
   /**
-   * @brief Name of thread
+   * @brief Type of event
    *
    */
-  ThreadName thread_name;
+  Type event_type;
 };
 
+static_assert(std::is_trivially_copyable<Event>::value,
+              "Event must be trivially copyable");
+
 /**
  * @brief Function object to compute hash value for an event object.
  *
@@ -146,25 +195,361 @@ class EventHash {
     // Implemented hash function based on comment in
     // https://stackoverflow.com/questions/20511347/a-good-hash-function-for-a-vector
 
-    size_t seed = event.GetOperationName().size();
-    seed ^= std::hash<int>()((int)event.GetEventType()) + 0x9e3779b9 +
+    size_t seed = event.GetOperationId();
+    seed ^= static_cast<size_t>(event.GetEventType()) + 0x9e3779b9 +
             (seed << 6) + (seed >> 2);
-    for (auto &i : event.GetOperationName()) {
-      seed ^= i + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-    }
-    for (auto &i : event.GetThreadName()) {
-      seed ^= i + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-    }
+    seed ^= event.GetThreadId() + 0x9e3779b9 + (seed << 6) + (seed >> 2);
 
     return seed;
   }
 };
 
 /**
- * @brief EventList Type
+ * @brief Event List Class
+ *
+ * Contiguous storage of a sequence of events. The events are stored in a
+ * structure-of-arrays layout with separate columns for thread identifiers,
+ * operation identifiers and event types. Comparison and hashing operate
+ * directly on the columns so that they can be vectorized by the compiler.
+ *
+ * Events can optionally carry timestamps which are stored in an additional
+ * column. The column is empty as long as no timestamped event is added, and
+ * timestamps are ignored when comparing or hashing lists.
+ *
+ * The list supports the usual sequence container operations. Since the events
+ * are not stored as objects, element access and iteration return events by
+ * value.
+ *
+ * @note The list used to be a `std::list<Event>`. Loops binding the events
+ * by `const auto &`, `auto &&` or by value still compile, while loops binding
+ * them by `auto &` do not, and events can no longer be modified in place:
+ * build a new list instead.
  *
  */
-typedef std::list<Event> EventList;
+class EventList {
+ public:
+  /**
+   * @brief Iterator over the events in the list. Dereferencing yields an event
+   * by value, so the iterator is tagged as an input iterator although it
+   * supports random access arithmetic.
+   *
+   */
+  class const_iterator {
+   public:
+    typedef std::input_iterator_tag iterator_category;
+    typedef Event value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Event reference;
+
+    /**
+     * @brief Pointer-like proxy holding a copy of the event.
+     *
+     */
+    class pointer {
+     public:
+      explicit pointer(const Event &event) : event(event) {}
+      const Event *operator->() const { return &event; }
+
+     private:
+      Event event;
+    };
+
+    const_iterator() : list(nullptr), index(0) {}
+    const_iterator(const EventList *list, size_t index)
+        : list(list), index(index) {}
+
+    reference operator*() const { return (*list)[index]; }
+    pointer operator->() const { return pointer((*list)[index]); }
+    reference operator[](difference_type n) const {
+      return (*list)[index + n];
+    }
+
+    const_iterator &operator++() {
+      ++index;
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator it = *this;
+      ++index;
+      return it;
+    }
+    const_iterator &operator--() {
+      --index;
+      return *this;
+    }
+    const_iterator operator--(int) {
+      const_iterator it = *this;
+      --index;
+      return it;
+    }
+    const_iterator &operator+=(difference_type n) {
+      index += n;
+      return *this;
+    }
+    const_iterator &operator-=(difference_type n) {
+      index -= n;
+      return *this;
+    }
+    const_iterator operator+(difference_type n) const {
+      return const_iterator(list, index + n);
+    }
+    const_iterator operator-(difference_type n) const {
+      return const_iterator(list, index - n);
+    }
+    difference_type operator-(const const_iterator &other) const {
+      return static_cast<difference_type>(index) -
+             static_cast<difference_type>(other.index);
+    }
+
+    bool operator==(const const_iterator &other) const {
+      return index == other.index;
+    }
+    bool operator!=(const const_iterator &other) const {
+      return index != other.index;
+    }
+    bool operator<(const const_iterator &other) const {
+      return index < other.index;
+    }
+    bool operator>(const const_iterator &other) const {
+      return index > other.index;
+    }
+    bool operator<=(const const_iterator &other) const {
+      return index <= other.index;
+    }
+    bool operator>=(const const_iterator &other) const {
+      return index >= other.index;
+    }
+
+   private:
+    const EventList *list;
+    size_t index;
+  };
+
+  typedef Event value_type;
+  typedef size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef Event reference;
+  typedef Event const_reference;
+  typedef const_iterator iterator;
+
+  /**
+   * @brief Construct a new Event List object
+   *
+   */
+  EventList() = default;
+
+  /**
+   * @brief Construct a new Event List object
+   *
+   * @param events Initializer list of events
+   */
+  EventList(std::initializer_list<Event> events) {
+    reserve(events.size());
+    for (const auto &event : events) {
+      push_back(event);
+    }
+  }
+
+  /**
+   * @brief Construct a new Event List object from a range of events
+   *
+   * @param first Iterator to the first event of the range
+   * @param last Iterator past the last event of the range
+   */
+  template <class InputIterator>
+  EventList(InputIterator first, InputIterator last) {
+    for (; first != last; ++first) {
+      push_back(*first);
+    }
+  }
+
+  /**
+   * @brief Reserve capacity for the given number of events.
+   *
+   */
+  void reserve(size_t capacity) {
+    thread_ids.reserve(capacity);
+    operation_ids.reserve(capacity);
+    event_types.reserve(capacity);
+    if (!timestamps.empty()) {
+      timestamps.reserve(capacity);
+    }
+  }
+
+  /**
+   * @brief Get number of events the list can hold without reallocation.
+   *
+   */
+  size_t capacity() const { return thread_ids.capacity(); }
+
+  /**
+   * @brief Get number of events in the list.
+   *
+   */
+  size_t size() const { return thread_ids.size(); }
+
+  /**
+   * @brief Check if the list is empty.
+   *
+   */
+  bool empty() const { return thread_ids.empty(); }
+
+  /**
+   * @brief Append an event to the end of the list.
+   *
+   */
+  void push_back(const Event &event) {
+    thread_ids.push_back(event.GetThreadId());
+    operation_ids.push_back(event.GetOperationId());
+    event_types.push_back(event.GetEventType());
+    if (!timestamps.empty()) {
+      timestamps.push_back(0);
+    }
+  }
+
+  /**
+   * @brief Append a timestamped event to the end of the list. Events added
+   * earlier without timestamp get a zero timestamp.
+   *
+   */
+  void push_back(const Event &event, Timestamp timestamp) {
+    if (timestamps.size() < thread_ids.size()) {
+      timestamps.reserve(thread_ids.capacity());
+      timestamps.resize(thread_ids.size(), 0);
+    }
+    thread_ids.push_back(event.GetThreadId());
+    operation_ids.push_back(event.GetOperationId());
+    event_types.push_back(event.GetEventType());
+    timestamps.push_back(timestamp);
+  }
+
+  /**
+   * @brief Remove the last event in the list.
+   *
+   */
+  void pop_back() {
+    thread_ids.pop_back();
+    operation_ids.pop_back();
+    event_types.pop_back();
+    if (!timestamps.empty()) {
+      timestamps.pop_back();
+    }
+  }
+
+  /**
+   * @brief Remove all events while retaining the allocated capacity.
+   *
+   */
+  void clear() {
+    thread_ids.clear();
+    operation_ids.clear();
+    event_types.clear();
+    timestamps.clear();
+  }
+
+  /**
+   * @brief Get event at given position.
+   *
+   */
+  Event operator[](size_t index) const {
+    return {thread_ids[index], operation_ids[index], event_types[index]};
+  }
+
+  /**
+   * @brief Get the first event.
+   *
+   */
+  Event front() const { return (*this)[0]; }
+
+  /**
+   * @brief Get the last event.
+   *
+   */
+  Event back() const { return (*this)[size() - 1]; }
+
+  /**
+   * @brief Get iterator to the first event.
+   *
+   */
+  const_iterator begin() const { return const_iterator(this, 0); }
+
+  /**
+   * @brief Get iterator past the last event.
+   *
+   */
+  const_iterator end() const { return const_iterator(this, size()); }
+
+  /**
+   * @brief Get the column of thread identifiers.
+   *
+   */
+  const std::vector<SymbolId> &GetThreadIds() const { return thread_ids; }
+
+  /**
+   * @brief Get the column of operation identifiers.
+   *
+   */
+  const std::vector<SymbolId> &GetOperationIds() const {
+    return operation_ids;
+  }
+
+  /**
+   * @brief Get the column of event types.
+   *
+   */
+  const std::vector<Event::Type> &GetEventTypes() const { return event_types; }
+
+  /**
+   * @brief Get the column of timestamps. The column is empty if no timestamped
+   * event was added to the list.
+   *
+   */
+  const std::vector<Timestamp> &GetTimestamps() const { return timestamps; }
+
+  /**
+   * @brief Check if the events in the list carry timestamps.
+   *
+   */
+  bool HasTimestamps() const { return !timestamps.empty(); }
+
+  /**
+   * @brief Equality comparision operator
+   *
+   */
+  bool operator==(const EventList &other) const {
+    return thread_ids == other.thread_ids &&
+           operation_ids == other.operation_ids &&
+           event_types == other.event_types;
+  }
+
+  /**
+   * @brief Inequality comparision operator
+   *
+   */
+  bool operator!=(const EventList &other) const { return !(*this == other); }
+
+  TSTEST_PRIVATE
+  /**
+   * @brief Column of thread identifiers
+   *
+   */
+  std::vector<SymbolId> thread_ids;
+  /**
+   * @brief Column of operation identifiers
+   *
+   */
+  std::vector<SymbolId> operation_ids;
+  /**
+   * @brief Column of event types
+   *
+   */
+  std::vector<Event::Type> event_types;
+  /**
+   * @brief Column of timestamps
+   *
+   */
+  std::vector<Timestamp> timestamps;
+};
 
 /**
  * @brief Hash function object for event list.
@@ -175,20 +560,33 @@ class EventListHash {
   /**
    * @brief Compute hash value for given event list
    *
+   * The hash of each event is mixed with its position and the results are
+   * summed. Since the terms are independent of each other the loop can be
+   * vectorized.
+   *
    * @param event_list Constant reference to event list
    * @returns Hash value for the given event list
    */
   size_t operator()(const EventList &event_list) const {
-    // Implemented hash function based on comment in
-    // https://stackoverflow.com/questions/20511347/a-good-hash-function-for-a-vector
+    const size_t size = event_list.size();
+    const SymbolId *thread_ids = event_list.GetThreadIds().data();
+    const SymbolId *operation_ids = event_list.GetOperationIds().data();
+    const Event::Type *event_types = event_list.GetEventTypes().data();
 
-    size_t seed = event_list.size();
-    EventHash event_hash;
-    for (auto &event : event_list) {
-      seed ^= event_hash(event) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    uint64_t sum = 0;
+    for (size_t i = 0; i < size; ++i) {
+      uint64_t term =
+          (static_cast<uint64_t>(operation_ids[i]) << 32) | thread_ids[i];
+      term ^= (static_cast<uint64_t>(event_types[i]) + 1) *
+              0x94d049bb133111ebULL;
+      term ^= (i + 1) * 0x9e3779b97f4a7c15ULL;
+      term ^= term >> 29;
+      term *= 0xbf58476d1ce4e5b9ULL;
+      term ^= term >> 32;
+      sum += term;
     }
 
-    return seed;
+    return static_cast<size_t>(sum ^ size);
   }
 };
 
@@ -0,0 +1,183 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#ifndef TSTEST__DETAILS__EVENT_BUFFER_HPP
+#define TSTEST__DETAILS__EVENT_BUFFER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include <tstest/details/annotations.hpp>
+#include <tstest/details/clock.hpp>
+#include <tstest/details/event.hpp>
+#include <tstest/details/mutex.hpp>
+
+namespace tstest {
+namespace details {
+
+/**
+ * @brief Sequence stamp type
+ *
+ * Global sequence number assigned to an event at the time it is logged. The
+ * stamps of a single event log are unique and strictly increasing.
+ *
+ */
+typedef uint64_t Sequence;
+
+/**
+ * @brief Event Record Class
+ *
+ * An event along with the global sequence stamp and the timestamp taken when
+ * it was logged.
+ *
+ */
+struct EventRecord {
+  /**
+   * @brief Global sequence stamp of the event
+   *
+   */
+  Sequence sequence;
+  /**
+   * @brief Timestamp of the event, zero if not timestamped
+   *
+   */
+  Timestamp timestamp;
+  /**
+   * @brief Logged event
+   *
+   */
+  Event event;
+};
+
+/**
+ * @brief Event Buffer Class
+ *
+ * A preallocated single-producer buffer of event records. Each execution
+ * context writes to its own buffer so that pushing an event does not require
+ * any synchronization with other threads. The buffers are merged into a single
+ * chronologically ordered event list once all the producers have finished.
+ *
+ * @note The class is not thread safe. Only one thread should push into a
+ * buffer and the buffer should only be read after that thread has been joined,
+ * except through `Snapshot`.
+ *
+ */
+class EventBuffer {
+ public:
+  /**
+   * @brief Construct a new Event Buffer object
+   *
+   * @param capacity Number of event records to preallocate
+   */
+  explicit EventBuffer(size_t capacity) : published(0) {
+    records.reserve(capacity);
+  }
+
+  /**
+   * @brief Push an event record into the buffer. The buffer grows beyond its
+   * preallocated capacity if needed.
+   *
+   * @thread_unsafe
+   *
+   * @param sequence Global sequence stamp of the event
+   * @param event Constant reference to the event to push
+   * @param timestamp Timestamp of the event
+   */
+  void Push(Sequence sequence, const Event &event, Timestamp timestamp = 0) {
+    if (records.size() == records.capacity()) {
+      // Records move when the buffer grows, which readers must not observe
+      LockGuard guard(growth);
+      records.push_back({sequence, timestamp, event});
+    } else {
+      records.push_back({sequence, timestamp, event});
+    }
+    published.store(records.size(), std::memory_order_release);
+  }
+
+  /**
+   * @brief Get the records in the buffer ordered by their sequence stamps.
+   *
+   * @thread_unsafe
+   *
+   * @returns Constant reference to the records
+   */
+  const std::vector<EventRecord> &GetRecords() const { return records; }
+
+  /**
+   * @brief Get a copy of the records pushed so far. Safe to call while the
+   * producer thread is pushing records.
+   *
+   * @thread_safe
+   *
+   * @returns Records ordered by their sequence stamps
+   */
+  std::vector<EventRecord> Snapshot() const {
+    LockGuard guard(growth);
+
+    const EventRecord *data = records.data();
+    return std::vector<EventRecord>(
+        data, data + published.load(std::memory_order_acquire));
+  }
+
+  /**
+   * @brief Get size of the buffer.
+   *
+   * @thread_unsafe
+   *
+   * @returns Number of records in the buffer
+   */
+  size_t Size() const { return records.size(); }
+
+  /**
+   * @brief Get the preallocated capacity of the buffer.
+   *
+   * @thread_unsafe
+   *
+   * @returns Number of records the buffer can hold without reallocation
+   */
+  size_t Capacity() const { return records.capacity(); }
+
+  /**
+   * @brief Remove all records while retaining the allocated capacity.
+   *
+   * @thread_unsafe
+   *
+   */
+  void Clear() {
+    records.clear();
+    published.store(0, std::memory_order_release);
+  }
+
+  TSTEST_PRIVATE
+  /**
+   * @brief Lock taken by the producer when the records move and by readers
+   * of snapshots
+   *
+   */
+  typedef typename tstest::details::Mutex<std::mutex> Mutex;
+  mutable Mutex growth;
+  typedef typename tstest::details::LockGuard<Mutex> LockGuard;
+
+  /**
+   * @brief Number of records visible to snapshots
+   *
+   */
+  std::atomic<size_t> published;
+
+  /**
+   * @brief Records ordered by sequence stamp
+   *
+   */
+  std::vector<EventRecord> records;
+};
+
+}  // namespace details
+}  // namespace tstest
+
+#endif /* TSTEST__DETAILS__EVENT_BUFFER_HPP */
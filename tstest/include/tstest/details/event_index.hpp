@@ -0,0 +1,188 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#ifndef TSTEST__DETAILS__EVENT_INDEX_HPP
+#define TSTEST__DETAILS__EVENT_INDEX_HPP
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+#include <tstest/details/event.hpp>
+
+namespace tstest {
+namespace details {
+
+/**
+ * @brief Event Range Class
+ *
+ * A contiguous read-only range of events in an event list.
+ *
+ */
+class EventRange {
+ public:
+  /**
+   * @brief Construct a new Event Range object
+   *
+   * @param first Iterator to the first event of the range
+   * @param last Iterator past the last event of the range
+   */
+  EventRange(EventList::const_iterator first, EventList::const_iterator last)
+      : first(first), last(last) {}
+
+  /**
+   * @brief Get iterator to the first event.
+   *
+   */
+  EventList::const_iterator begin() const { return first; }
+
+  /**
+   * @brief Get iterator past the last event.
+   *
+   */
+  EventList::const_iterator end() const { return last; }
+
+  /**
+   * @brief Get number of events in the range.
+   *
+   */
+  size_t size() const { return static_cast<size_t>(last - first); }
+
+  /**
+   * @brief Check if the range is empty.
+   *
+   */
+  bool empty() const { return first == last; }
+
+ private:
+  EventList::const_iterator first;
+  EventList::const_iterator last;
+};
+
+/**
+ * @brief Event Index Class
+ *
+ * Index over an immutable event list answering occurrence and per-thread
+ * queries in constant time. The position of an event in the indexed list is
+ * used as its sequence number.
+ *
+ * @note The index stores a reference to the event list which must outlive the
+ * index and must not be modified.
+ *
+ */
+class EventIndex {
+ public:
+  /**
+   * @brief Position returned when no matching event is found.
+   *
+   */
+  static constexpr size_t npos = static_cast<size_t>(-1);
+
+  /**
+   * @brief List of event positions.
+   *
+   */
+  typedef std::vector<size_t> PositionList;
+
+  /**
+   * @brief Construct a new Event Index object
+   *
+   * @param events Constant reference to the list of events to index
+   */
+  explicit EventIndex(const EventList &events) : events(events) {
+    const std::vector<SymbolId> &thread_ids = events.GetThreadIds();
+    for (size_t i = 0; i < events.size(); ++i) {
+      occurrences[events[i]].push_back(i);
+      thread_events[thread_ids[i]].push_back(i);
+    }
+  }
+
+  /**
+   * @brief Check if the given event occurs in the indexed list.
+   *
+   * @param event Constant reference to the event to check
+   * @returns `true` if the event occurs else `false`
+   */
+  bool Contains(const Event &event) const {
+    return occurrences.find(event) != occurrences.end();
+  }
+
+  /**
+   * @brief Get number of occurrences of the given event.
+   *
+   * @param event Constant reference to the event to count
+   * @returns Number of occurrences
+   */
+  size_t Count(const Event &event) const {
+    auto it = occurrences.find(event);
+    return it == occurrences.end() ? 0 : it->second.size();
+  }
+
+  /**
+   * @brief Get position of the k-th occurrence of the given event.
+   *
+   * @param event Constant reference to the event to find
+   * @param k Zero based occurrence number
+   * @returns Position of the occurrence or `npos` if not found
+   */
+  size_t Find(const Event &event, size_t k = 0) const {
+    auto it = occurrences.find(event);
+    if (it == occurrences.end() || k >= it->second.size()) {
+      return npos;
+    }
+    return it->second[k];
+  }
+
+  /**
+   * @brief Get positions of all the events logged by the given thread.
+   *
+   * @param thread_id Symbol identifier of the thread name
+   * @returns Constant reference to the ordered list of positions
+   */
+  const PositionList &GetThreadEvents(SymbolId thread_id) const {
+    static const PositionList empty;
+    auto it = thread_events.find(thread_id);
+    return it == thread_events.end() ? empty : it->second;
+  }
+
+  /**
+   * @brief Get the events with sequence numbers in the range [first, last).
+   * The range is clamped to the size of the indexed list.
+   *
+   * @param first Sequence number of the first event
+   * @param last Sequence number past the last event
+   * @returns Range of events
+   */
+  EventRange Between(size_t first, size_t last) const {
+    last = std::min(last, events.size());
+    first = std::min(first, last);
+    return EventRange(events.begin() + first, events.begin() + last);
+  }
+
+  TSTEST_PRIVATE
+  /**
+   * @brief Indexed list of events
+   *
+   */
+  const EventList &events;
+  /**
+   * @brief Mapping between events and ordered positions of their occurrences
+   *
+   */
+  std::unordered_map<Event, PositionList, EventHash> occurrences;
+  /**
+   * @brief Mapping between thread identifiers and ordered positions of the
+   * events logged by them
+   *
+   */
+  std::unordered_map<SymbolId, PositionList> thread_events;
+};
+
+}  // namespace details
+}  // namespace tstest
+
+#endif /* TSTEST__DETAILS__EVENT_INDEX_HPP */
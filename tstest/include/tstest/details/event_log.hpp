@@ -8,21 +8,109 @@
 #ifndef TSTEST__DETAILS__EVENT_LOG_HPP
 #define TSTEST__DETAILS__EVENT_LOG_HPP
 
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <queue>
+#include <vector>
+
+#include <tstest/details/clock.hpp>
 #include <tstest/details/defs.hpp>
 #include <tstest/details/event.hpp>
+#include <tstest/details/event_buffer.hpp>
+#include <tstest/details/event_index.hpp>
+#include <tstest/details/exception.hpp>
 #include <tstest/details/annotations.hpp>
 #include <tstest/details/mutex.hpp>
 
 namespace tstest {
 namespace details {
 
+/**
+ * @brief Event Listener Interface
+ *
+ * A listener is notified of every event added to the chronologically ordered
+ * list of an event log. In the SHARED mode listeners are notified as events
+ * are pushed, while holding the log lock. In the BUFFERED mode they are
+ * notified when the buffers are merged.
+ *
+ */
+class EventListener {
+ public:
+  virtual ~EventListener() = default;
+
+  /**
+   * @brief Called for each event added to the log.
+   *
+   * @param event Constant reference to the added event
+   * @param timestamp Timestamp of the event, zero if not timestamped
+   * @returns `false` to cancel the run producing the events else `true`
+   */
+  virtual bool OnEvent(const Event &event, Timestamp timestamp) = 0;
+};
+
 /**
  * @brief Event Log Class
  *
  * The event log contains chronologically ordered sequence of operational
- * events pushed by one or more threads during testing.
+ * events pushed by one or more threads during testing. The log supports the
+ * following modes:
+ *
+ * - SHARED: Events are pushed directly into a single list guarded by a lock.
+ * - BUFFERED: Each producer thread writes sequence stamped events into its own
+ *   preallocated buffer without taking any lock. The buffers are merged into
+ *   the chronologically ordered list by calling `Merge` once all the producers
+ *   have finished.
+ *
+ * Once no more events are expected, e.g. after all the threads of a run are
+ * joined, the log can be sealed. A sealed log is immutable and hands out a
+ * read-only view of its events without taking the lock or copying. Queries
+ * on a sealed log are answered using an index which is built lazily on the
+ * first query.
+ *
+ * Events can optionally be timestamped by the execution contexts when they are
+ * logged. The timestamps are stored in the event list of the log.
+ *
+ * A log can also be cancelled, either by a listener or explicitly. Execution
+ * contexts stop logging operations of a cancelled log by throwing the
+ * `RunCancelled` error.
  */
 class EventLog {
+ public:
+  /**
+   * @brief Enumerated list of logging modes.
+   *
+   */
+  enum class Mode { SHARED = 0, BUFFERED };
+
+  /**
+   * @brief Default number of event records preallocated per buffer.
+   *
+   */
+  static constexpr size_t kDefaultBufferCapacity = 1024;
+
+  /**
+   * @brief Construct a new Event Log object
+   *
+   * @param mode Logging mode
+   * @param buffer_capacity Number of event records preallocated per buffer in
+   * the BUFFERED mode
+   * @param timestamped Flag indicating that events should be timestamped
+   */
+  explicit EventLog(Mode mode = Mode::SHARED,
+                    size_t buffer_capacity = kDefaultBufferCapacity,
+                    bool timestamped = false)
+      : mode(mode),
+        buffer_capacity(buffer_capacity),
+        timestamped(timestamped),
+        sequence(0),
+        active_buffers(0),
+        sealed(false),
+        cancelled(false),
+        index_ptr(nullptr) {}
+
   TSTEST_PRIVATE
   /**
    * @brief Re-enterent Lock for mutual exclusion
@@ -39,7 +127,402 @@ class EventLog {
    */
   EventList events GUARDED_BY(lock);
 
+  /**
+   * @brief Logging mode
+   *
+   */
+  Mode mode;
+
+  /**
+   * @brief Number of event records preallocated per buffer
+   *
+   */
+  size_t buffer_capacity;
+
+  /**
+   * @brief Flag indicating that events should be timestamped
+   *
+   */
+  bool timestamped;
+
+  /**
+   * @brief Global sequence counter used to stamp buffered events
+   *
+   */
+  std::atomic<Sequence> sequence;
+
+  /**
+   * @brief Per-thread event buffers. A list is used so that buffer addresses
+   * remain stable while new buffers are created. Buffers are retained after
+   * being merged and handed out again so that repeated runs do not reallocate.
+   *
+   */
+  std::list<EventBuffer> buffers GUARDED_BY(lock);
+
+  /**
+   * @brief Number of buffers handed out which are yet to be merged. These are
+   * the first buffers of the list.
+   *
+   */
+  size_t active_buffers GUARDED_BY(lock);
+
+  /**
+   * @brief Mark all buffers as free, retaining their allocated capacity.
+   *
+   */
+  void ReleaseBuffers() REQUIRES(lock) {
+    auto it = buffers.begin();
+    for (size_t i = 0; i < active_buffers; ++i, ++it) {
+      it->Clear();
+    }
+    active_buffers = 0;
+  }
+
+  /**
+   * @brief Flag indicating that the log is sealed
+   *
+   */
+  std::atomic<bool> sealed;
+
+  /**
+   * @brief Flag indicating that the run producing the events is cancelled
+   *
+   */
+  std::atomic<bool> cancelled;
+
+  /**
+   * @brief Listeners notified of added events
+   *
+   */
+  std::vector<EventListener *> listeners GUARDED_BY(lock);
+
+  /**
+   * @brief Add an event to the ordered list and notify the listeners.
+   *
+   */
+  void Append(const Event &event, Timestamp timestamp) REQUIRES(lock) {
+    if (timestamped) {
+      events.push_back(event, timestamp);
+    } else {
+      events.push_back(event);
+    }
+    for (auto listener : listeners) {
+      if (!listener->OnEvent(event, timestamp)) {
+        cancelled.store(true, std::memory_order_release);
+      }
+    }
+  }
+
+  /**
+   * @brief Index over the events of the sealed log. Built on first query and
+   * dropped when the log is unsealed.
+   *
+   */
+  mutable std::unique_ptr<EventIndex> index GUARDED_BY(lock);
+  mutable std::atomic<const EventIndex *> index_ptr;
+
+  /**
+   * @brief Get the index over the events of the sealed log, building it if
+   * needed. An exception is thrown if the log is not sealed.
+   *
+   */
+  const EventIndex &GetIndex() const {
+    if (!IsSealed()) {
+      throw EventLogNotSealed();
+    }
+    const EventIndex *ptr = index_ptr.load(std::memory_order_acquire);
+    if (ptr == nullptr) {
+      LockGuard guard(lock);
+
+      if (!index) {
+        index.reset(new EventIndex(events));
+        index_ptr.store(index.get(), std::memory_order_release);
+      }
+      ptr = index.get();
+    }
+    return *ptr;
+  }
+
  public:
+  /**
+   * @brief Position returned by queries when no matching event is found.
+   *
+   */
+  static constexpr size_t npos = EventIndex::npos;
+
+  /**
+   * @brief Get the logging mode.
+   *
+   * @returns Logging mode of the event log
+   */
+  Mode GetMode() const { return mode; }
+
+  /**
+   * @brief Check if events should be timestamped when logged.
+   *
+   * @returns `true` if events are timestamped else `false`
+   */
+  bool IsTimestamped() const { return timestamped; }
+
+  /**
+   * @brief Reserve capacity in the log for the given number of events so that
+   * pushing them does not reallocate.
+   *
+   * @thread_safe
+   *
+   * @param capacity Number of events
+   */
+  void Reserve(size_t capacity) {
+    LockGuard guard(lock);
+
+    events.reserve(capacity);
+  }
+
+  /**
+   * @brief Add a listener notified of every event added to the log. The
+   * listener must outlive the log or be removed before it is destroyed.
+   *
+   * @thread_safe
+   *
+   * @param listener Pointer to the listener
+   */
+  void AddListener(EventListener *listener) {
+    LockGuard guard(lock);
+
+    listeners.push_back(listener);
+  }
+
+  /**
+   * @brief Remove a previously added listener.
+   *
+   * @thread_safe
+   *
+   * @param listener Pointer to the listener
+   */
+  void RemoveListener(EventListener *listener) {
+    LockGuard guard(lock);
+
+    listeners.erase(std::remove(listeners.begin(), listeners.end(), listener),
+                    listeners.end());
+  }
+
+  /**
+   * @brief Cancel the run producing the events of the log.
+   *
+   * @thread_safe
+   *
+   */
+  void Cancel() { cancelled.store(true, std::memory_order_release); }
+
+  /**
+   * @brief Clear the cancellation of the log.
+   *
+   * @thread_safe
+   *
+   */
+  void ResetCancel() { cancelled.store(false, std::memory_order_release); }
+
+  /**
+   * @brief Check if the run producing the events of the log is cancelled.
+   *
+   * @thread_safe
+   *
+   * @returns `true` if cancelled else `false`
+   */
+  bool IsCancelled() const {
+    return cancelled.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Get a copy of the most recent events of the log. Safe to call while
+   * threads are pushing events. In the BUFFERED mode the events in the buffers
+   * which are yet to be merged follow the ordered list, in the order of their
+   * sequence stamps.
+   *
+   * @thread_safe
+   *
+   * @param count Maximum number of events
+   * @returns Most recent events, oldest first
+   */
+  EventList Snapshot(size_t count = SIZE_MAX) const {
+    LockGuard guard(lock);
+
+    std::vector<EventRecord> records;
+    auto buffer = buffers.begin();
+    for (size_t i = 0; i < active_buffers; ++i, ++buffer) {
+      std::vector<EventRecord> buffered = buffer->Snapshot();
+      records.insert(records.end(), buffered.begin(), buffered.end());
+    }
+    std::sort(records.begin(), records.end(),
+              [](const EventRecord &a, const EventRecord &b) {
+                return a.sequence < b.sequence;
+              });
+
+    size_t total = events.size() + records.size();
+    size_t first = total > count ? total - count : 0;
+    EventList result;
+    result.reserve(total - first);
+    for (size_t i = first; i < events.size(); ++i) {
+      result.push_back(events[i]);
+    }
+    first = first > events.size() ? first - events.size() : 0;
+    for (size_t i = first; i < records.size(); ++i) {
+      result.push_back(records[i].event);
+    }
+    return result;
+  }
+
+  /**
+   * @brief Get an empty single-producer buffer owned by the log. Buffers
+   * released by a previous `Merge` or `Clear` are reused before new ones are
+   * allocated. The buffer is valid until the next call to `Merge`.
+   *
+   * @thread_safe
+   *
+   * @returns Pointer to the buffer
+   */
+  EventBuffer *CreateBuffer() {
+    LockGuard guard(lock);
+
+    if (active_buffers == buffers.size()) {
+      buffers.emplace_back(buffer_capacity);
+    }
+    return &*std::next(buffers.begin(), active_buffers++);
+  }
+
+  /**
+   * @brief Take the next global sequence stamp.
+   *
+   * @thread_safe
+   *
+   * @returns Sequence stamp
+   */
+  Sequence Stamp() { return sequence.fetch_add(1, std::memory_order_relaxed); }
+
+  /**
+   * @brief Merge the events in all the buffers into the log in the order of
+   * their sequence stamps, and release the buffers for reuse.
+   *
+   * @note All the threads writing into the buffers must have been joined
+   * before calling this method.
+   *
+   * @thread_safe
+   *
+   */
+  void Merge() {
+    LockGuard guard(lock);
+
+    if (sealed.load(std::memory_order_acquire)) {
+      throw EventLogSealed();
+    }
+
+    // Cursor into a buffer: current position and end of the buffer records
+    typedef std::pair<std::vector<EventRecord>::const_iterator,
+                      std::vector<EventRecord>::const_iterator>
+        Cursor;
+    auto later = [](const Cursor &a, const Cursor &b) {
+      return a.first->sequence > b.first->sequence;
+    };
+    std::priority_queue<Cursor, std::vector<Cursor>, decltype(later)> heap(
+        later);
+    size_t total = events.size();
+    auto buffer = buffers.begin();
+    for (size_t i = 0; i < active_buffers; ++i, ++buffer) {
+      const auto &records = buffer->GetRecords();
+      if (!records.empty()) {
+        heap.push({records.begin(), records.end()});
+        total += records.size();
+      }
+    }
+    events.reserve(total);
+    // K-way merge of the buffers which are individually ordered
+    while (!heap.empty()) {
+      Cursor cursor = heap.top();
+      heap.pop();
+      Append(cursor.first->event, cursor.first->timestamp);
+      if (++cursor.first != cursor.second) {
+        heap.push(cursor);
+      }
+    }
+    ReleaseBuffers();
+  }
+
+  /**
+   * @brief Remove all events from the log while retaining the allocated
+   * capacity. The log is unsealed and its cancellation cleared.
+   *
+   * @note Should only be called when no thread is pushing into or reading a
+   * view of the log.
+   *
+   * @thread_safe
+   *
+   */
+  void Clear() {
+    LockGuard guard(lock);
+
+    events.clear();
+    ReleaseBuffers();
+    sequence.store(0, std::memory_order_relaxed);
+    sealed.store(false, std::memory_order_release);
+    cancelled.store(false, std::memory_order_release);
+    index_ptr.store(nullptr, std::memory_order_release);
+    index.reset();
+  }
+
+  /**
+   * @brief Seal the log. No events can be pushed into a sealed log.
+   *
+   * @thread_safe
+   *
+   */
+  void Seal() {
+    LockGuard guard(lock);
+
+    sealed.store(true, std::memory_order_release);
+  }
+
+  /**
+   * @brief Unseal the log so that events can be pushed again. Views obtained
+   * while the log was sealed are invalidated by subsequent pushes.
+   *
+   * @note Should only be called when no thread is reading a view of the log.
+   *
+   * @thread_safe
+   *
+   */
+  void Unseal() {
+    LockGuard guard(lock);
+
+    sealed.store(false, std::memory_order_release);
+    index_ptr.store(nullptr, std::memory_order_release);
+    index.reset();
+  }
+
+  /**
+   * @brief Check if the log is sealed.
+   *
+   * @thread_safe
+   *
+   * @returns `true` if the log is sealed else `false`
+   */
+  bool IsSealed() const { return sealed.load(std::memory_order_acquire); }
+
+  /**
+   * @brief Get a read-only view of the events in a sealed log. The view is
+   * accessed without taking the lock or copying the events. An exception is
+   * thrown if the log is not sealed.
+   *
+   * @thread_safe
+   *
+   * @returns Constant reference to the event list
+   */
+  const EventList &View() const NO_THREAD_SAFETY_ANALYSIS {
+    if (!IsSealed()) {
+      throw EventLogNotSealed();
+    }
+    return events;
+  }
+
   /**
    * @brief Push an event into the log.
    *
@@ -50,7 +533,44 @@ class EventLog {
   void Push(const Event &event) {
     LockGuard guard(lock);
 
-    events.push_back(event);
+    if (sealed.load(std::memory_order_relaxed)) {
+      throw EventLogSealed();
+    }
+    Append(event, 0);
+  }
+
+  /**
+   * @brief Push a timestamped event into the log.
+   *
+   * @thread_safe
+   *
+   * @param event Constant reference to the event to push
+   * @param timestamp Timestamp of the event
+   */
+  void Push(const Event &event, Timestamp timestamp) {
+    LockGuard guard(lock);
+
+    if (sealed.load(std::memory_order_relaxed)) {
+      throw EventLogSealed();
+    }
+    Append(event, timestamp);
+  }
+
+  /**
+   * @brief Push an event into the log, timestamped once the lock of the log
+   * is held so that the wait for the lock is not part of the timestamp.
+   *
+   * @thread_safe
+   *
+   * @param event Constant reference to the event to push
+   */
+  void PushNow(const Event &event) {
+    LockGuard guard(lock);
+
+    if (sealed.load(std::memory_order_relaxed)) {
+      throw EventLogSealed();
+    }
+    Append(event, timestamped ? Clock::Now() : 0);
   }
 
   /**
@@ -63,7 +583,10 @@ class EventLog {
   void Push(Event &&event) {
     LockGuard guard(lock);
 
-    events.push_back(event);
+    if (sealed.load(std::memory_order_relaxed)) {
+      throw EventLogSealed();
+    }
+    Append(event, 0);
   }
 
   /**
@@ -104,7 +627,8 @@ class EventLog {
   }
 
   /**
-   * @brief Check if the log contains the given event.
+   * @brief Check if the log contains the given event. The check takes
+   * constant time on a sealed log and linear time otherwise.
    *
    * @thread_safe
    *
@@ -112,6 +636,10 @@ class EventLog {
    * @returns `true` if the list contains the event else `false`
    */
   bool Contains(const Event &event) const {
+    if (IsSealed()) {
+      return GetIndex().Contains(event);
+    }
+
     LockGuard guard(lock);
 
     auto it = events.begin();
@@ -126,7 +654,8 @@ class EventLog {
   }
 
   /**
-   * @brief Check if the log contains the given event.
+   * @brief Check if the log contains the given event. The check takes
+   * constant time on a sealed log and linear time otherwise.
    *
    * @thread_safe
    *
@@ -134,6 +663,10 @@ class EventLog {
    * @returns `true` if the list contains the event else `false`
    */
   bool Contains(Event &&event) const {
+    if (IsSealed()) {
+      return GetIndex().Contains(event);
+    }
+
     LockGuard guard(lock);
 
     auto it = events.begin();
@@ -147,6 +680,61 @@ class EventLog {
     return false;
   }
 
+  /**
+   * @brief Get number of occurrences of the given event in a sealed log. An
+   * exception is thrown if the log is not sealed.
+   *
+   * @thread_safe
+   *
+   * @param event Constant reference to the event to count
+   * @returns Number of occurrences
+   */
+  size_t Count(const Event &event) const { return GetIndex().Count(event); }
+
+  /**
+   * @brief Get position of the k-th occurrence of the given event in a sealed
+   * log. An exception is thrown if the log is not sealed.
+   *
+   * @thread_safe
+   *
+   * @param event Constant reference to the event to find
+   * @param k Zero based occurrence number
+   * @returns Position of the occurrence or `npos` if not found
+   */
+  size_t Find(const Event &event, size_t k = 0) const {
+    return GetIndex().Find(event, k);
+  }
+
+  /**
+   * @brief Get positions of all the events logged by the given thread in a
+   * sealed log. An exception is thrown if the log is not sealed.
+   *
+   * @thread_safe
+   *
+   * @param thread_name Constant reference to the thread name
+   * @returns Constant reference to the ordered list of positions
+   */
+  const EventIndex::PositionList &GetThreadEvents(
+      const ThreadName &thread_name) const {
+    // Looked up by hash without interning the queried name
+    return GetIndex().GetThreadEvents(
+        HashSymbol(thread_name.data(), thread_name.size()));
+  }
+
+  /**
+   * @brief Get the events of a sealed log with positions in the range [first,
+   * last). An exception is thrown if the log is not sealed.
+   *
+   * @thread_safe
+   *
+   * @param first Position of the first event
+   * @param last Position past the last event
+   * @returns Range of events
+   */
+  EventRange Between(size_t first, size_t last) const {
+    return GetIndex().Between(first, last);
+  }
+
   /**
    * @brief Get size of the log.
    *
@@ -166,11 +754,24 @@ class EventLog {
    * @thread_safe
    *
    */
-  bool operator==(const std::list<Event> &other) const {
+  bool operator==(const EventList &other) const {
     LockGuard guard(lock);
 
     return events == other;
   }
+
+  /**
+   * @brief Equality comparision operator.
+   *
+   * @thread_safe
+   *
+   */
+  bool operator==(const std::list<Event> &other) const {
+    LockGuard guard(lock);
+
+    return events.size() == other.size() &&
+           std::equal(events.begin(), events.end(), other.begin());
+  }
 };
 
 }  // namespace details
@@ -8,6 +8,9 @@
 #ifndef TSTEST__DETAILS__EXCEPTION_HPP
 #define TSTEST__DETAILS__EXCEPTION_HPP
 
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
 #include <exception>
 #include <string>
 
@@ -27,9 +30,9 @@ class NoAssertionFunctionFound : public std::exception {
   std::string msg;
 
  public:
-  NoAssertionFunctionFound(EventList &event_list)
+  NoAssertionFunctionFound(const EventList &event_list)
       : msg("No assertion function found for event sequence:\n") {
-    for (auto &event : event_list) {
+    for (const auto &event : event_list) {
       msg = msg + event.ToString() + ",\n";
     }
   }
@@ -37,6 +40,150 @@ class NoAssertionFunctionFound : public std::exception {
   const char *what() const throw() { return msg.c_str(); }
 };
 
+/**
+ * Event Log Sealed Error
+ *
+ * This error is thrown if events are pushed into a sealed event log.
+ */
+class EventLogSealed : public std::exception {
+ public:
+  const char *what() const throw() {
+    return "Cannot push events into a sealed event log";
+  }
+};
+
+/**
+ * Event Log Not Sealed Error
+ *
+ * This error is thrown if a read-only view is requested from an event log
+ * which is not sealed.
+ */
+class EventLogNotSealed : public std::exception {
+ public:
+  const char *what() const throw() {
+    return "Cannot view events of an event log which is not sealed";
+  }
+};
+
+/**
+ * Run Cancelled Error
+ *
+ * This error is thrown from the execution context of a thread function when
+ * the run it belongs to is cancelled. The runner catches the error so that the
+ * thread function stops at its next operation.
+ */
+class RunCancelled : public std::exception {
+ public:
+  const char *what() const throw() { return "Run cancelled"; }
+};
+
+/**
+ * Schedule Diverged Error
+ *
+ * This error is thrown if the threads of a run cannot be driven through a
+ * given schedule, e.g. because they log different events.
+ */
+class ScheduleDiverged : public std::exception {
+ private:
+  std::string msg;
+
+ public:
+  ScheduleDiverged(const EventList &schedule)
+      : msg("Run diverged from event sequence:\n") {
+    for (const auto &event : schedule) {
+      msg = msg + event.ToString() + ",\n";
+    }
+  }
+
+  const char *what() const throw() { return msg.c_str(); }
+};
+
+/**
+ * Seeded Run Failed Error
+ *
+ * This error is thrown if a randomized run fails. It carries the seed which
+ * reproduces the run.
+ */
+class SeededRunFailed : public std::exception {
+ private:
+  std::string msg;
+  uint64_t seed;
+
+ public:
+  SeededRunFailed(uint64_t seed, const std::string &reason) : seed(seed) {
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "Run with seed 0x%016" PRIx64,
+                  seed);
+    msg = std::string(buffer) + " failed: " + reason;
+  }
+
+  uint64_t GetSeed() const { return seed; }
+
+  const char *what() const throw() { return msg.c_str(); }
+};
+
+/**
+ * Trace Error
+ *
+ * This error is thrown if a trace file cannot be written or read.
+ */
+class TraceError : public std::exception {
+ private:
+  std::string msg;
+
+ public:
+  TraceError(const std::string &path, const std::string &reason)
+      : msg("Trace file \"" + path + "\": " + reason) {}
+
+  const char *what() const throw() { return msg.c_str(); }
+};
+
+/**
+ * Invalid Placement Error
+ *
+ * This error is thrown if a thread is pinned to a CPU it is not allowed to run
+ * on.
+ */
+class InvalidPlacement : public std::exception {
+ private:
+  std::string msg;
+
+ public:
+  explicit InvalidPlacement(unsigned int cpu)
+      : msg("CPU " + std::to_string(cpu) + " is not available for placement") {}
+
+  const char *what() const throw() { return msg.c_str(); }
+};
+
+/**
+ * Run Timed Out Error
+ *
+ * This error is thrown if a run did not finish within its deadline and was
+ * cancelled. It carries the report of the hung run.
+ */
+class RunTimedOut : public std::exception {
+ private:
+  std::string msg;
+
+ public:
+  explicit RunTimedOut(const std::string &report) : msg(report) {}
+
+  const char *what() const throw() { return msg.c_str(); }
+};
+
+/**
+ * Schedule Count Overflow Error
+ *
+ * This error is thrown if the number of schedules of a list of events does not
+ * fit into 64 bits.
+ */
+class ScheduleCountOverflow : public std::exception {
+ public:
+  const char *what() const throw() {
+    return "Number of schedules exceeds 64 bits";
+  }
+};
+
 }  // namespace details
 }  // namespace tstest
 
@@ -0,0 +1,375 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#ifndef TSTEST__DETAILS__EXECUTOR_HPP
+#define TSTEST__DETAILS__EXECUTOR_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <tstest/details/affinity.hpp>
+#include <tstest/details/assertor.hpp>
+#include <tstest/details/runner.hpp>
+
+namespace tstest {
+namespace details {
+
+/**
+ * @brief Executor Options
+ *
+ * Configuration used when constructing a `ScenarioExecutor`.
+ *
+ */
+struct ExecutorOptions {
+  /**
+   * @brief CPUs to run the scenarios on, all available CPUs if empty.
+   *
+   */
+  std::vector<CpuId> cpus;
+  /**
+   * @brief Flag indicating that each scenario should be pinned to CPUs not
+   * used by any other scenario running at the same time.
+   *
+   */
+  bool isolate = false;
+  /**
+   * @brief Counter of the failures reported without throwing, as in
+   * `PCTOptions::failures`. A scenario whose run sees the count grow fails.
+   * The counter is read from the worker threads, one at a time. As scenarios
+   * run in parallel, a failure is also attributed to the other scenarios
+   * running at the time it is reported.
+   *
+   */
+  std::function<size_t()> failures;
+};
+
+/**
+ * @brief Scenario Result
+ *
+ * Outcome of a scenario executed by a `ScenarioExecutor`.
+ *
+ */
+struct ScenarioResult {
+  /**
+   * @brief Name of the scenario
+   *
+   */
+  std::string name;
+  /**
+   * @brief Flag indicating that all runs of the scenario were asserted
+   * without an exception or a failure reported to the failure counter
+   *
+   */
+  bool passed = false;
+  /**
+   * @brief Description of the error which failed the scenario
+   *
+   */
+  std::string error;
+  /**
+   * @brief Number of runs completed
+   *
+   */
+  size_t runs = 0;
+  /**
+   * @brief CPUs the scenario was pinned to, empty if not isolated
+   *
+   */
+  std::vector<CpuId> cpus;
+  /**
+   * @brief CPUs the placed threads of the last run were pinned to
+   *
+   */
+  std::unordered_map<ThreadName, CpuInfo> placement;
+  /**
+   * @brief Wall time spent running the scenario
+   *
+   */
+  std::chrono::nanoseconds elapsed = std::chrono::nanoseconds::zero();
+};
+
+/**
+ * @brief Executor Report
+ *
+ * Results of all the scenarios executed by a `ScenarioExecutor`.
+ *
+ */
+struct ExecutorReport {
+  /**
+   * @brief Get number of failed scenarios.
+   *
+   */
+  size_t Failed() const {
+    return std::count_if(
+        results.begin(), results.end(),
+        [](const ScenarioResult &result) { return !result.passed; });
+  }
+
+  /**
+   * @brief Get number of scenarios executed per second.
+   *
+   */
+  double Throughput() const {
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    return seconds > 0 ? results.size() / seconds : 0;
+  }
+
+  /**
+   * @brief Get number of scenario runs completed per second.
+   *
+   */
+  double RunThroughput() const {
+    size_t runs = 0;
+    for (const auto &result : results) {
+      runs += result.runs;
+    }
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    return seconds > 0 ? runs / seconds : 0;
+  }
+
+  /**
+   * @brief Results in the order the scenarios were added
+   *
+   */
+  std::vector<ScenarioResult> results;
+  /**
+   * @brief Wall time spent executing all scenarios
+   *
+   */
+  std::chrono::nanoseconds elapsed = std::chrono::nanoseconds::zero();
+};
+
+/**
+ * @brief Scenario Executor Class
+ *
+ * Executes many independent scenarios, each a runner with an assertor, in
+ * parallel. Scenarios are packed onto the CPUs so that the threads of the
+ * scenarios running at the same time do not exceed the number of CPUs.
+ * Scenarios with more threads are started first. Optionally, each scenario is
+ * pinned to its own CPUs so that scenarios do not disturb each other.
+ *
+ * @note A runner should not be added more than once. Use the number of runs
+ * to repeat a scenario.
+ *
+ */
+class ScenarioExecutor {
+ public:
+  /**
+   * @brief Construct a new Scenario Executor object
+   *
+   * @param options Constant reference to the executor options
+   */
+  explicit ScenarioExecutor(const ExecutorOptions &options = ExecutorOptions())
+      : options(options) {
+    if (this->options.cpus.empty()) {
+      this->options.cpus = GetAvailableCpus();
+    }
+  }
+
+  /**
+   * @brief Add a scenario.
+   *
+   * @param name Constant reference to the scenario name
+   * @param runner Reference to the runner of the scenario
+   * @param assertor Constant reference to the assertor of the scenario
+   * @param runs Number of times the scenario is run and asserted
+   */
+  void Add(const std::string &name, Runner &runner, const Assertor &assertor,
+           size_t runs = 1) {
+    scenarios.push_back({name, &runner, &assertor, runs});
+  }
+
+  /**
+   * @brief Execute all added scenarios and wait for them to finish.
+   *
+   * @returns Report of the executed scenarios
+   */
+  ExecutorReport Run() {
+    ExecutorReport report;
+    report.results.resize(scenarios.size());
+    // Scenarios with more threads first
+    order.resize(scenarios.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+      order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+      return scenarios[a].runner->GetThreadCount() >
+             scenarios[b].runner->GetThreadCount();
+    });
+    next = 0;
+    free_cpus.assign(options.cpus.size(), true);
+    free_count = options.cpus.size();
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    size_t worker_count = std::min(options.cpus.size(), scenarios.size());
+    for (size_t i = 0; i < worker_count; ++i) {
+      workers.emplace_back(&ScenarioExecutor::Work, this, std::ref(report));
+    }
+    for (auto &worker : workers) {
+      worker.join();
+    }
+    report.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start);
+    return report;
+  }
+
+  TSTEST_PRIVATE
+  /**
+   * @brief Scenario to execute
+   *
+   */
+  struct Scenario {
+    std::string name;
+    Runner *runner;
+    const Assertor *assertor;
+    size_t runs;
+  };
+
+  /**
+   * @brief Worker loop taking the next scenario once enough CPUs are free.
+   *
+   */
+  void Work(ExecutorReport &report) {
+    std::unique_lock<std::mutex> guard(lock);
+    while (next < order.size()) {
+      size_t index = order[next++];
+      Scenario &scenario = scenarios[index];
+      size_t need = std::max<size_t>(1, scenario.runner->GetThreadCount());
+      need = std::min(need, options.cpus.size());
+      released.wait(guard, [this, need]() { return free_count >= need; });
+      // Claim the CPUs
+      std::vector<size_t> claimed;
+      for (size_t i = 0; i < free_cpus.size() && claimed.size() < need; ++i) {
+        if (free_cpus[i]) {
+          free_cpus[i] = false;
+          claimed.push_back(i);
+        }
+      }
+      free_count -= need;
+      guard.unlock();
+
+      ScenarioResult &result = report.results[index];
+      result.name = scenario.name;
+      if (options.isolate) {
+        for (auto i : claimed) {
+          result.cpus.push_back(options.cpus[i]);
+        }
+        scenario.runner->SetAffinity(result.cpus);
+      }
+      Execute(scenario, result);
+      result.placement = scenario.runner->GetPlacement();
+      if (options.isolate) {
+        scenario.runner->SetAffinity({});
+      }
+
+      // Release the CPUs
+      guard.lock();
+      for (auto i : claimed) {
+        free_cpus[i] = true;
+      }
+      free_count += need;
+      released.notify_all();
+    }
+  }
+
+  /**
+   * @brief Run and assert a scenario recording the outcome.
+   *
+   */
+  void Execute(Scenario &scenario, ScenarioResult &result) {
+    auto start = std::chrono::steady_clock::now();
+    result.passed = true;
+    try {
+      for (; result.runs < scenario.runs; ++result.runs) {
+        size_t failures = CountFailures();
+        scenario.runner->Run(*scenario.assertor);
+        if (CountFailures() > failures) {
+          result.passed = false;
+          result.error = "failure reported by the run";
+          break;
+        }
+      }
+    } catch (const std::exception &error) {
+      result.passed = false;
+      result.error = error.what();
+    }
+    result.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start);
+  }
+
+  /**
+   * @brief Read the failure counter of the options, zero if there is none.
+   *
+   */
+  size_t CountFailures() {
+    if (!options.failures) {
+      return 0;
+    }
+    std::lock_guard<std::mutex> guard(failures_lock);
+    return options.failures();
+  }
+
+  /**
+   * @brief Executor options
+   *
+   */
+  ExecutorOptions options;
+  /**
+   * @brief Added scenarios
+   *
+   */
+  std::vector<Scenario> scenarios;
+  /**
+   * @brief Lock guarding the scheduling state
+   *
+   */
+  std::mutex lock;
+  /**
+   * @brief Lock serializing the reads of the failure counter
+   *
+   */
+  std::mutex failures_lock;
+  /**
+   * @brief Condition signalled when CPUs are released
+   *
+   */
+  std::condition_variable released;
+  /**
+   * @brief Indices of the scenarios in the order they are started
+   *
+   */
+  std::vector<size_t> order;
+  /**
+   * @brief Position of the next scenario to start in the order
+   *
+   */
+  size_t next = 0;
+  /**
+   * @brief Flags indicating the free CPUs
+   *
+   */
+  std::vector<bool> free_cpus;
+  /**
+   * @brief Number of free CPUs
+   *
+   */
+  size_t free_count = 0;
+};
+
+}  // namespace details
+}  // namespace tstest
+
+#endif /* TSTEST__DETAILS__EXECUTOR_HPP */
@@ -0,0 +1,85 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#ifndef TSTEST__DETAILS__INDEPENDENCE_HPP
+#define TSTEST__DETAILS__INDEPENDENCE_HPP
+
+#include <cstdint>
+#include <unordered_set>
+
+#include <tstest/details/defs.hpp>
+#include <tstest/details/event.hpp>
+#include <tstest/details/symbol_table.hpp>
+
+namespace tstest {
+namespace details {
+
+/**
+ * @brief Independence Class
+ *
+ * Declares pairs of operations which are independent, i.e. commute, such as
+ * operations on different keys or two reads. Adjacent events of different
+ * threads whose operations are independent can be swapped without changing
+ * the outcome of a run. Schedules which only differ by such swaps belong to
+ * the same Mazurkiewicz trace and describe the same behavior.
+ *
+ */
+class Independence {
+ public:
+  /**
+   * @brief Declare two operations independent of each other. An operation
+   * may be declared independent of itself.
+   *
+   * @param operation_a Constant reference to the first operation name
+   * @param operation_b Constant reference to the second operation name
+   */
+  void Add(const OperationName &operation_a, const OperationName &operation_b) {
+    SymbolId a = SymbolTable::Instance().Intern(operation_a);
+    SymbolId b = SymbolTable::Instance().Intern(operation_b);
+    pairs.insert(Key(a, b));
+    pairs.insert(Key(b, a));
+  }
+
+  /**
+   * @brief Check if no operations have been declared independent.
+   *
+   */
+  bool Empty() const { return pairs.empty(); }
+
+  /**
+   * @brief Check if two events are independent. Events of the same thread
+   * are never independent.
+   *
+   * @param a Constant reference to the first event
+   * @param b Constant reference to the second event
+   * @returns `true` if independent else `false`
+   */
+  bool IsIndependent(const Event &a, const Event &b) const {
+    return a.GetThreadId() != b.GetThreadId() &&
+           pairs.count(Key(a.GetOperationId(), b.GetOperationId())) > 0;
+  }
+
+  TSTEST_PRIVATE
+  /**
+   * @brief Get the key of an ordered pair of operation identifiers.
+   *
+   */
+  static uint64_t Key(SymbolId a, SymbolId b) {
+    return (static_cast<uint64_t>(a) << 32) | b;
+  }
+
+  /**
+   * @brief Ordered pairs of independent operations, stored both ways
+   *
+   */
+  std::unordered_set<uint64_t> pairs;
+};
+
+}  // namespace details
+}  // namespace tstest
+
+#endif /* TSTEST__DETAILS__INDEPENDENCE_HPP */
@@ -0,0 +1,245 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#ifndef TSTEST__DETAILS__LATENCY_HPP
+#define TSTEST__DETAILS__LATENCY_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <tstest/details/clock.hpp>
+#include <tstest/details/event.hpp>
+
+namespace tstest {
+namespace details {
+
+/**
+ * @brief Latency Histogram Class
+ *
+ * Histogram of operation latencies in nanoseconds. The histogram keeps all the
+ * recorded samples so that percentiles are exact, along with power of two
+ * buckets for a compact overview of the distribution.
+ *
+ */
+class LatencyHistogram {
+ public:
+  /**
+   * @brief Record a latency sample.
+   *
+   * @param latency Latency in nanoseconds
+   */
+  void Add(double latency) {
+    samples.push_back(latency);
+    sorted = false;
+    size_t bucket =
+        latency < 1.0 ? 0 : 1 + static_cast<size_t>(std::log2(latency));
+    if (bucket >= buckets.size()) {
+      buckets.resize(bucket + 1, 0);
+    }
+    ++buckets[bucket];
+  }
+
+  /**
+   * @brief Get number of recorded samples.
+   *
+   */
+  size_t Count() const { return samples.size(); }
+
+  /**
+   * @brief Get the latency at the given percentile using the nearest-rank
+   * method. Returns zero if no samples were recorded.
+   *
+   * @param percentile Percentile in the range [0, 100]
+   * @returns Latency in nanoseconds
+   */
+  double Percentile(double percentile) const {
+    if (samples.empty()) {
+      return 0;
+    }
+    Sort();
+    double rank = std::ceil(percentile / 100.0 * samples.size());
+    size_t index = rank < 1 ? 0 : static_cast<size_t>(rank) - 1;
+    return samples[std::min(index, samples.size() - 1)];
+  }
+
+  /**
+   * @brief Get the minimum recorded latency.
+   *
+   */
+  double Min() const { return Percentile(0); }
+
+  /**
+   * @brief Get the maximum recorded latency.
+   *
+   */
+  double Max() const { return Percentile(100); }
+
+  /**
+   * @brief Get the mean of the recorded latencies.
+   *
+   */
+  double Mean() const {
+    if (samples.empty()) {
+      return 0;
+    }
+    double sum = 0;
+    for (auto sample : samples) {
+      sum += sample;
+    }
+    return sum / samples.size();
+  }
+
+  /**
+   * @brief Get the power of two buckets. Bucket `0` counts latencies below one
+   * nanosecond and bucket `i > 0` counts latencies in [2^(i-1), 2^i).
+   *
+   */
+  const std::vector<size_t> &GetBuckets() const { return buckets; }
+
+  TSTEST_PRIVATE
+  /**
+   * @brief Sort the samples if needed.
+   *
+   */
+  void Sort() const {
+    if (!sorted) {
+      std::sort(samples.begin(), samples.end());
+      sorted = true;
+    }
+  }
+
+  /**
+   * @brief Recorded samples
+   *
+   */
+  mutable std::vector<double> samples;
+  /**
+   * @brief Flag indicating that the samples are sorted
+   *
+   */
+  mutable bool sorted = true;
+  /**
+   * @brief Power of two buckets
+   *
+   */
+  std::vector<size_t> buckets;
+};
+
+/**
+ * @brief Latency Report Class
+ *
+ * The report pairs each BEGIN event with the matching END event of the same
+ * operation in the same thread and records the elapsed time in a histogram
+ * per operation. Events are required to carry timestamps, see
+ * `RunnerOptions::timestamps`. Event lists of several runs can be added to
+ * the same report.
+ *
+ * BEGIN events are timestamped after waiting for the log and END events
+ * before, so that lock contention is not counted. In the SHARED log mode a
+ * latency still includes the listeners of the log notified of the BEGIN
+ * event, e.g. a `TraceWriter` writing to its file.
+ *
+ */
+class LatencyReport {
+ public:
+  /**
+   * @brief Add the latencies of the operations in the given event list. An
+   * END event without matching BEGIN is ignored, as are BEGIN events left
+   * open at the end of the list.
+   *
+   * @param event_list Constant reference to a timestamped list of events
+   */
+  void Add(const EventList &event_list) {
+    if (!event_list.HasTimestamps()) {
+      return;
+    }
+    const std::vector<Timestamp> &timestamps = event_list.GetTimestamps();
+    // Open BEGIN timestamps keyed by thread and operation identifiers
+    std::unordered_map<uint64_t, std::vector<Timestamp>> open;
+    for (size_t i = 0; i < event_list.size(); ++i) {
+      Event event = event_list[i];
+      uint64_t key = (static_cast<uint64_t>(event.GetThreadId()) << 32) |
+                     event.GetOperationId();
+      std::vector<Timestamp> &stack = open[key];
+      if (event.GetEventType() == Event::Type::BEGIN) {
+        stack.push_back(timestamps[i]);
+      } else if (!stack.empty()) {
+        Timestamp begin = stack.back();
+        stack.pop_back();
+        Timestamp end = std::max(begin, timestamps[i]);
+        histograms[event.GetOperationId()].Add(
+            Clock::ToNanoseconds(end - begin));
+      }
+    }
+  }
+
+  /**
+   * @brief Get the histogram of an operation. An empty histogram is returned
+   * for operations without recorded latencies.
+   *
+   * @param operation_name Constant reference to the operation name
+   * @returns Constant reference to the histogram
+   */
+  const LatencyHistogram &Get(const OperationName &operation_name) const {
+    static const LatencyHistogram empty;
+    SymbolId operation_id =
+        HashSymbol(operation_name.data(), operation_name.size());
+    auto it = histograms.find(operation_id);
+    return it == histograms.end() ? empty : it->second;
+  }
+
+  /**
+   * @brief Get the histograms of all operations keyed by operation identifier.
+   *
+   */
+  const std::unordered_map<SymbolId, LatencyHistogram> &GetHistograms() const {
+    return histograms;
+  }
+
+  /**
+   * @brief String representation of the report with one line per operation
+   * ordered by operation name.
+   *
+   * @returns report string
+   */
+  std::string ToString() const {
+    std::map<std::string, const LatencyHistogram *> ordered;
+    for (const auto &element : histograms) {
+      ordered[SymbolTable::Instance().Resolve(element.first)] = &element.second;
+    }
+    std::string report;
+    char line[256];
+    std::snprintf(line, sizeof(line), "%-24s %10s %12s %12s %12s\n",
+                  "operation", "count", "p50 (ns)", "p99 (ns)", "max (ns)");
+    report += line;
+    for (const auto &element : ordered) {
+      std::snprintf(line, sizeof(line), "%-24s %10zu %12.0f %12.0f %12.0f\n",
+                    element.first.c_str(), element.second->Count(),
+                    element.second->Percentile(50),
+                    element.second->Percentile(99), element.second->Max());
+      report += line;
+    }
+    return report;
+  }
+
+  TSTEST_PRIVATE
+  /**
+   * @brief Histograms keyed by operation identifier
+   *
+   */
+  std::unordered_map<SymbolId, LatencyHistogram> histograms;
+};
+
+}  // namespace details
+}  // namespace tstest
+
+#endif /* TSTEST__DETAILS__LATENCY_HPP */
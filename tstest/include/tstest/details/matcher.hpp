@@ -0,0 +1,195 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#ifndef TSTEST__DETAILS__MATCHER_HPP
+#define TSTEST__DETAILS__MATCHER_HPP
+
+#include <unordered_map>
+#include <vector>
+
+#include <tstest/details/assertor.hpp>
+#include <tstest/details/event_log.hpp>
+#include <tstest/details/symmetry.hpp>
+
+namespace tstest {
+namespace details {
+
+/**
+ * @brief Streaming Matcher Class
+ *
+ * The matcher compiles the event lists in the dispatch table of an assertor
+ * into a trie and advances through it as events are logged. As soon as the
+ * observed events are no longer a prefix of any event list in the table the
+ * matcher reports that no match is possible. When attached to an event log as
+ * listener, this cancels the run so that it can stop early. If the assertor has
+ * groups of interchangeable threads, the observed events are matched in their
+ * canonical form.
+ *
+ * @note The class is not thread safe. When used as a listener the event log
+ * serializes the calls to `OnEvent`.
+ *
+ */
+class StreamingMatcher : public EventListener {
+ public:
+  /**
+   * @brief Construct a new Streaming Matcher object
+   *
+   * @param assertor Constant reference to the assertor whose dispatch table is
+   * compiled. Changes made to the assertor afterwards are not reflected.
+   */
+  explicit StreamingMatcher(const Assertor &assertor)
+      : nodes(1),
+        state(0),
+        dead(false),
+        depth(0),
+        symmetry(assertor.GetSymmetry()),
+        canonicalizer(symmetry) {
+    for (const auto &element : assertor.GetDispatchTable()) {
+      size_t node = 0;
+      for (const auto &event : element.first) {
+        auto it = nodes[node].children.find(event);
+        if (it == nodes[node].children.end()) {
+          // Taking the index before growing the node vector
+          size_t child = nodes.size();
+          nodes[node].children.emplace(event, child);
+          nodes.emplace_back();
+          node = child;
+        } else {
+          node = it->second;
+        }
+      }
+      nodes[node].terminal = true;
+    }
+  }
+
+  /**
+   * @brief Reset the matcher to the empty sequence of events.
+   *
+   */
+  void Reset() {
+    state = 0;
+    dead = false;
+    depth = 0;
+    canonicalizer.Reset();
+  }
+
+  /**
+   * @brief Advance the matcher by an observed event.
+   *
+   * @param event Constant reference to the observed event
+   * @returns `false` if no event list in the dispatch table can match the
+   * observed events anymore else `true`
+   */
+  bool Advance(const Event &event) {
+    if (dead) {
+      return false;
+    }
+    auto it = nodes[state].children.find(
+        symmetry.Empty() ? event : canonicalizer.Next(event));
+    if (it == nodes[state].children.end()) {
+      dead = true;
+      return false;
+    }
+    state = it->second;
+    ++depth;
+    return true;
+  }
+
+  /**
+   * @brief Check if the observed events can no longer match.
+   *
+   * @returns `true` if no match is possible else `false`
+   */
+  bool IsDead() const { return dead; }
+
+  /**
+   * @brief Check if the observed events exactly match an event list in the
+   * dispatch table.
+   *
+   * @returns `true` if matched else `false`
+   */
+  bool IsMatch() const { return !dead && nodes[state].terminal; }
+
+  /**
+   * @brief Get number of events matched so far.
+   *
+   * @returns Length of the matched prefix
+   */
+  size_t GetDepth() const { return depth; }
+
+  /**
+   * @brief Get number of nodes in the compiled trie.
+   *
+   * @returns Number of trie nodes including the root
+   */
+  size_t Size() const { return nodes.size(); }
+
+  /**
+   * @brief Advance the matcher by an event added to the event log.
+   *
+   * @param event Constant reference to the added event
+   * @param timestamp Timestamp of the event
+   * @returns `false` to cancel the run once no match is possible
+   */
+  bool OnEvent(const Event &event, Timestamp /*timestamp*/) override {
+    return Advance(event);
+  }
+
+  TSTEST_PRIVATE
+  /**
+   * @brief Trie node
+   *
+   */
+  struct Node {
+    /**
+     * @brief Mapping between the next event and the child node index
+     *
+     */
+    std::unordered_map<Event, size_t, EventHash> children;
+    /**
+     * @brief Flag indicating that an event list ends at the node
+     *
+     */
+    bool terminal = false;
+  };
+
+  /**
+   * @brief Trie nodes with the root at index zero
+   *
+   */
+  std::vector<Node> nodes;
+  /**
+   * @brief Index of the current node
+   *
+   */
+  size_t state;
+  /**
+   * @brief Flag indicating that no match is possible
+   *
+   */
+  bool dead;
+  /**
+   * @brief Number of events matched so far
+   *
+   */
+  size_t depth;
+  /**
+   * @brief Groups of interchangeable threads of the assertor
+   *
+   */
+  SymmetryGroups symmetry;
+  /**
+   * @brief Canonicalizer of the observed events
+   *
+   */
+  SymmetryGroups::Canonicalizer canonicalizer;
+};
+
+}  // namespace details
+}  // namespace tstest
+
+#endif /* TSTEST__DETAILS__MATCHER_HPP */
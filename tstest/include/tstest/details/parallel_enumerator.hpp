@@ -0,0 +1,321 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#ifndef TSTEST__DETAILS__PARALLEL_ENUMERATOR_HPP
+#define TSTEST__DETAILS__PARALLEL_ENUMERATOR_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <tstest/details/affinity.hpp>
+#include <tstest/details/defs.hpp>
+#include <tstest/details/enumerator.hpp>
+#include <tstest/details/event.hpp>
+#include <tstest/details/schedule_space.hpp>
+
+namespace tstest {
+namespace details {
+
+/**
+ * @brief Parallel Options
+ *
+ * Configuration used when enumerating schedules with a `ParallelEnumerator`.
+ *
+ */
+struct ParallelOptions {
+  /**
+   * @brief Number of worker threads, one per available CPU if zero
+   *
+   */
+  size_t workers = 0;
+  /**
+   * @brief Number of schedules above which a subtree of the interleaving tree
+   * is split into the subtrees of its children instead of enumerated
+   *
+   */
+  uint64_t grain = 1024;
+  /**
+   * @brief Reductions applied to the enumeration
+   *
+   */
+  ScheduleOptions schedule;
+};
+
+/**
+ * @brief Parallel Enumerator Class
+ *
+ * Enumerates the schedules of a list of events on several worker threads and
+ * hands each schedule to a visitor. The interleaving tree is split by prefix:
+ * a task is a prefix of thread numbers, and a worker either splits it into
+ * one task per thread with events left, or enumerates the schedules starting
+ * with it once their number drops to the grain. Every worker keeps a deque of
+ * tasks, taking its own tasks from the back, depth first, and stealing tasks
+ * near the root from the front of the deques of the other workers when its
+ * own deque runs empty.
+ *
+ * The schedules visited are the same as those of a `ScheduleEnumerator` with
+ * the same schedule options, each visited once, in no particular order.
+ *
+ * @example
+ *
+ *  ParallelEnumerator enumerator(event_list);
+ *  enumerator.Run([&](const EventList &schedule, size_t worker) {
+ *    assertor.Get(schedule);
+ *  });
+ *
+ */
+class ParallelEnumerator {
+ public:
+  /**
+   * @brief Visitor type. The visitor is called concurrently from all the
+   * workers with a schedule and the index of the worker.
+   *
+   */
+  typedef std::function<void(const EventList &, size_t)> Visitor;
+
+  /**
+   * @brief Construct a new Parallel Enumerator object
+   *
+   * @param event_list Constant reference to the list of events
+   * @param options Constant reference to the parallel options
+   */
+  explicit ParallelEnumerator(const EventList &event_list,
+                              const ParallelOptions &options = ParallelOptions())
+      : event_list(event_list), options(options) {
+    if (this->options.workers == 0) {
+      this->options.workers = GetAvailableCpus().size();
+    }
+    for (const auto &events : SplitThreads(event_list)) {
+      counts.push_back(events.size());
+    }
+  }
+
+  /**
+   * @brief Get the number of worker threads.
+   *
+   */
+  size_t GetWorkerCount() const { return options.workers; }
+
+  /**
+   * @brief Visit all schedules and wait for the workers to finish. If the
+   * visitor throws, the workers stop and the first exception is rethrown.
+   *
+   * @param visitor Constant reference to the visitor
+   * @returns Size of the schedule space before and after reduction
+   */
+  ReductionReport Run(const Visitor &visitor) {
+    workers.clear();
+    for (size_t i = 0; i < options.workers; ++i) {
+      workers.emplace_back(new Worker());
+    }
+    // The root task holds every schedule
+    workers[0]->tasks.emplace_back();
+    outstanding = 1;
+    stopping = false;
+    error = nullptr;
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < workers.size(); ++i) {
+      threads.emplace_back(&ParallelEnumerator::Work, this, i,
+                           std::cref(visitor));
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    if (error) {
+      std::rethrow_exception(error);
+    }
+
+    ReductionReport report;
+    if (!ScheduleSpace::Multinomial(counts, report.total)) {
+      report.total = UINT64_MAX;
+    }
+    for (const auto &worker : workers) {
+      report.explored += worker->report.explored;
+      report.blocked += worker->report.blocked;
+    }
+    return report;
+  }
+
+  TSTEST_PRIVATE
+  /**
+   * @brief Worker
+   *
+   * State owned by a worker thread.
+   *
+   */
+  struct Worker {
+    /**
+     * @brief Lock guarding the tasks
+     *
+     */
+    std::mutex lock;
+    /**
+     * @brief Prefixes of the tasks, the most recently split at the back
+     *
+     */
+    std::deque<std::vector<size_t>> tasks;
+    /**
+     * @brief Schedules enumerated by the worker
+     *
+     */
+    ReductionReport report;
+  };
+
+  /**
+   * @brief Worker loop taking tasks until there are none left anywhere.
+   *
+   */
+  void Work(size_t index, const Visitor &visitor) {
+    ScheduleEnumerator enumerator(event_list, options.schedule);
+    std::vector<size_t> prefix;
+    while (!stopping) {
+      if (!Take(index, prefix)) {
+        if (outstanding == 0) {
+          return;
+        }
+        std::this_thread::yield();
+        continue;
+      }
+      try {
+        Process(index, prefix, enumerator, visitor);
+      } catch (...) {
+        std::lock_guard<std::mutex> guard(error_lock);
+        if (!error) {
+          error = std::current_exception();
+        }
+        stopping = true;
+      }
+      // Split tasks were added before the task is retired
+      --outstanding;
+    }
+  }
+
+  /**
+   * @brief Take the next task of a worker, or steal the oldest task of
+   * another worker.
+   *
+   * @returns `true` if a task was taken else `false`
+   */
+  bool Take(size_t index, std::vector<size_t> &prefix) {
+    {
+      Worker &own = *workers[index];
+      std::lock_guard<std::mutex> guard(own.lock);
+      if (!own.tasks.empty()) {
+        prefix = std::move(own.tasks.back());
+        own.tasks.pop_back();
+        return true;
+      }
+    }
+    for (size_t i = 1; i < workers.size(); ++i) {
+      Worker &victim = *workers[(index + i) % workers.size()];
+      std::lock_guard<std::mutex> guard(victim.lock);
+      if (!victim.tasks.empty()) {
+        prefix = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief Split a task into the tasks of its children if it holds more
+   * schedules than the grain, else visit its schedules.
+   *
+   */
+  void Process(size_t index, const std::vector<size_t> &prefix,
+               ScheduleEnumerator &enumerator, const Visitor &visitor) {
+    std::vector<size_t> left = counts;
+    for (auto thread : prefix) {
+      --left[thread];
+    }
+    // Complete schedules are enumerated whatever the grain
+    uint64_t size = 0;
+    if (prefix.size() < event_list.size() &&
+        (!ScheduleSpace::Multinomial(left, size) || size > options.grain)) {
+      Worker &own = *workers[index];
+      std::lock_guard<std::mutex> guard(own.lock);
+      // Lowest thread last, so that it is taken first
+      for (size_t thread = left.size(); thread-- > 0;) {
+        if (left[thread] > 0) {
+          own.tasks.push_back(prefix);
+          own.tasks.back().push_back(thread);
+          ++outstanding;
+        }
+      }
+      return;
+    }
+
+    // Schedules from the prefix up to the prefix of the next sibling
+    std::vector<size_t> last;
+    if (!prefix.empty()) {
+      last = prefix;
+      ++last.back();
+    }
+    enumerator.Seek(prefix, last);
+    while (!stopping && enumerator.Next()) {
+      visitor(enumerator.Get(), index);
+    }
+    ReductionReport &report = workers[index]->report;
+    report.explored += enumerator.GetReport().explored;
+    report.blocked += enumerator.GetReport().blocked;
+  }
+
+  /**
+   * @brief List of events
+   *
+   */
+  EventList event_list;
+  /**
+   * @brief Parallel options
+   *
+   */
+  ParallelOptions options;
+  /**
+   * @brief Number of events of each thread
+   *
+   */
+  std::vector<size_t> counts;
+  /**
+   * @brief Workers of the current run
+   *
+   */
+  std::vector<std::unique_ptr<Worker>> workers;
+  /**
+   * @brief Number of tasks added but not yet retired
+   *
+   */
+  std::atomic<size_t> outstanding;
+  /**
+   * @brief Flag indicating that the workers should stop
+   *
+   */
+  std::atomic<bool> stopping;
+  /**
+   * @brief Lock guarding the error
+   *
+   */
+  std::mutex error_lock;
+  /**
+   * @brief First exception thrown by the visitor
+   *
+   */
+  std::exception_ptr error;
+};
+
+}  // namespace details
+}  // namespace tstest
+
+#endif /* TSTEST__DETAILS__PARALLEL_ENUMERATOR_HPP */
@@ -0,0 +1,207 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#ifndef TSTEST__DETAILS__PLACEMENT_HPP
+#define TSTEST__DETAILS__PLACEMENT_HPP
+
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <tstest/details/affinity.hpp>
+#include <tstest/details/defs.hpp>
+#include <tstest/details/exception.hpp>
+
+namespace tstest {
+namespace details {
+
+/**
+ * @brief Placement
+ *
+ * Policy placing the threads of a thread function onto CPUs. Whether a race
+ * shows up often depends on whether the racing threads share a core, a socket
+ * or neither, so placements make such runs reproducible.
+ *
+ */
+struct Placement {
+  /**
+   * @brief Placement policies
+   *
+   */
+  enum class Policy {
+    // Pin to a given CPU
+    PIN,
+    // Spread across sockets, using distinct cores before SMT siblings
+    SPREAD,
+    // Co-locate on the SMT siblings of a core before moving to the next core
+    SIBLINGS,
+    // Move to the next CPU on every run
+    ROTATE
+  };
+
+  /**
+   * @brief Pin the threads to the given CPU.
+   *
+   */
+  static Placement Pin(CpuId cpu) { return {Policy::PIN, cpu}; }
+
+  /**
+   * @brief Spread the threads across sockets.
+   *
+   */
+  static Placement Spread() { return {Policy::SPREAD, 0}; }
+
+  /**
+   * @brief Co-locate the threads on SMT siblings.
+   *
+   */
+  static Placement Siblings() { return {Policy::SIBLINGS, 0}; }
+
+  /**
+   * @brief Rotate the threads over the CPUs from run to run.
+   *
+   */
+  static Placement Rotate() { return {Policy::ROTATE, 0}; }
+
+  /**
+   * @brief Placement policy
+   *
+   */
+  Policy policy;
+  /**
+   * @brief CPU of the PIN policy
+   *
+   */
+  CpuId cpu;
+};
+
+/**
+ * @brief Placement Planner Class
+ *
+ * Assigns CPUs of a topology to the threads of a run according to their
+ * placement policies. Threads sharing the SPREAD or SIBLINGS policy take
+ * consecutive CPUs of an order visiting the sockets round-robin or the
+ * siblings of each core in turn. Threads with the ROTATE policy are shifted by
+ * one CPU on each run. Once a policy runs out of CPUs it wraps around.
+ *
+ */
+class PlacementPlanner {
+ public:
+  /**
+   * @brief Construct a new Placement Planner object
+   *
+   * @param topology Topology of the CPUs threads are placed onto, not empty
+   */
+  explicit PlacementPlanner(std::vector<CpuInfo> topology)
+      : topology(std::move(topology)) {
+    std::sort(this->topology.begin(), this->topology.end(),
+              [](const CpuInfo &a, const CpuInfo &b) { return a.id < b.id; });
+
+    // Siblings of each core next to each other
+    siblings = this->topology;
+    std::stable_sort(siblings.begin(), siblings.end(),
+                     [](const CpuInfo &a, const CpuInfo &b) {
+                       return std::make_pair(a.socket, a.core) <
+                              std::make_pair(b.socket, b.core);
+                     });
+
+    // Per socket, one CPU of each core first, then the remaining siblings
+    std::map<unsigned int, std::vector<CpuInfo>> sockets;
+    std::map<unsigned int, size_t> first_sibling;
+    for (size_t i = 0; i < siblings.size(); ++i) {
+      const CpuInfo &info = siblings[i];
+      std::vector<CpuInfo> &cpus = sockets[info.socket];
+      if (i > 0 && siblings[i - 1].socket == info.socket &&
+          siblings[i - 1].core == info.core) {
+        cpus.push_back(info);
+      } else {
+        cpus.insert(cpus.begin() + first_sibling[info.socket]++, info);
+      }
+    }
+    // Visit the sockets round-robin
+    for (size_t round = 0; spread.size() < this->topology.size(); ++round) {
+      for (const auto &socket : sockets) {
+        if (round < socket.second.size()) {
+          spread.push_back(socket.second[round]);
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Start placing the threads of a run.
+   *
+   * @param iteration Number of runs placed before
+   */
+  void Start(size_t iteration) {
+    this->iteration = iteration;
+    spread_next = 0;
+    siblings_next = 0;
+    rotate_next = 0;
+  }
+
+  /**
+   * @brief Place the next thread of the run. An exception is thrown if a
+   * pinned CPU is not part of the topology.
+   *
+   * @param placement Constant reference to the placement of the thread
+   * @returns Constant reference to the CPU of the thread
+   */
+  const CpuInfo &Place(const Placement &placement) {
+    switch (placement.policy) {
+      case Placement::Policy::PIN:
+        for (const auto &info : topology) {
+          if (info.id == placement.cpu) {
+            return info;
+          }
+        }
+        throw InvalidPlacement(placement.cpu);
+      case Placement::Policy::SPREAD:
+        return spread[spread_next++ % spread.size()];
+      case Placement::Policy::SIBLINGS:
+        return siblings[siblings_next++ % siblings.size()];
+      case Placement::Policy::ROTATE:
+      default:
+        return topology[(rotate_next++ + iteration) % topology.size()];
+    }
+  }
+
+  TSTEST_PRIVATE
+  /**
+   * @brief CPUs ordered by identifier
+   *
+   */
+  std::vector<CpuInfo> topology;
+  /**
+   * @brief CPUs in the order used by the SPREAD policy
+   *
+   */
+  std::vector<CpuInfo> spread;
+  /**
+   * @brief CPUs in the order used by the SIBLINGS policy
+   *
+   */
+  std::vector<CpuInfo> siblings;
+  /**
+   * @brief Number of runs placed before the current one
+   *
+   */
+  size_t iteration = 0;
+  /**
+   * @brief Number of threads of the current run placed by each policy
+   *
+   */
+  size_t spread_next = 0;
+  size_t siblings_next = 0;
+  size_t rotate_next = 0;
+};
+
+}  // namespace details
+}  // namespace tstest
+
+#endif /* TSTEST__DETAILS__PLACEMENT_HPP */
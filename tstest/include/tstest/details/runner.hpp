@@ -8,12 +8,32 @@
 #ifndef TSTEST__DETAILS__RUNNER_HPP
 #define TSTEST__DETAILS__RUNNER_HPP
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <functional>
+#include <memory>
+#include <random>
 #include <thread>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
+#include <tstest/details/affinity.hpp>
+#include <tstest/details/algorithm.hpp>
+#include <tstest/details/assertor.hpp>
+#include <tstest/details/barrier.hpp>
+#include <tstest/details/clock.hpp>
 #include <tstest/details/context.hpp>
+#include <tstest/details/coverage.hpp>
+#include <tstest/details/enumerator.hpp>
 #include <tstest/details/event_log.hpp>
+#include <tstest/details/matcher.hpp>
+#include <tstest/details/placement.hpp>
+#include <tstest/details/scheduler.hpp>
+#include <tstest/details/symmetry.hpp>
+#include <tstest/details/watchdog.hpp>
+#include <tstest/details/worker_pool.hpp>
 
 namespace tstest {
 namespace details {
@@ -24,6 +44,102 @@ namespace details {
  */
 typedef std::function<void(ExecutionContext)> ThreadFunction;
 
+/**
+ * @brief Runner Options
+ *
+ * Configuration used when constructing a `Runner`.
+ *
+ */
+struct RunnerOptions {
+  /**
+   * @brief Mode of the event log. In the BUFFERED mode each thread logs events
+   * into its own buffer which are merged after all the threads are joined.
+   *
+   */
+  EventLog::Mode log_mode = EventLog::Mode::SHARED;
+  /**
+   * @brief Number of events preallocated per thread in the BUFFERED mode.
+   *
+   */
+  size_t buffer_capacity = EventLog::kDefaultBufferCapacity;
+  /**
+   * @brief Flag indicating that logged events should be timestamped. BEGIN
+   * events are timestamped after waiting for the log lock, END events before.
+   * The time taken by the listeners of the log notified of a BEGIN event, in
+   * the SHARED mode, is part of the latency of the operation.
+   *
+   */
+  bool timestamps = false;
+  /**
+   * @brief Flag indicating that thread functions should run on a persistent
+   * pool of worker threads reused across runs instead of new threads. In this
+   * mode each run starts from a cleared event log which keeps its allocated
+   * capacity.
+   *
+   */
+  bool reuse_threads = false;
+  /**
+   * @brief Time a run is allowed to take before it is considered hung, no
+   * deadline if zero. Runs are watched by a monitor thread which reports the
+   * threads that did not finish, the operations begun but not ended and the
+   * last events of the log.
+   *
+   */
+  std::chrono::milliseconds deadline = std::chrono::milliseconds::zero();
+  /**
+   * @brief Action taken when the deadline of a run expires. ABORT prints the
+   * report and aborts the process. CANCEL cancels the run, so that its threads
+   * stop at their next event, and `Run` throws a `RunTimedOut` error carrying
+   * the report. A cancelled run that still does not finish within the deadline
+   * aborts the process.
+   *
+   */
+  Watchdog::Action deadline_action = Watchdog::Action::ABORT;
+};
+
+/**
+ * @brief PCT Options
+ *
+ * Configuration of randomized runs using the `PCTScheduler`.
+ *
+ */
+struct PCTOptions {
+  /**
+   * @brief Number of randomized runs.
+   *
+   */
+  size_t iterations = 1000;
+  /**
+   * @brief Number of priority change points per run. Bugs needing one more
+   * ordering constraint than this number are found with a guaranteed
+   * probability.
+   *
+   */
+  size_t change_points = 2;
+  /**
+   * @brief Seed of the first run, each following run using the next seed. A
+   * random seed is drawn if zero.
+   *
+   */
+  uint64_t seed = 0;
+  /**
+   * @brief Listener called before each run with its seed and index, e.g. to
+   * print or record the seed.
+   *
+   */
+  std::function<void(uint64_t, size_t)> listener;
+  /**
+   * @brief Counter of the failures reported without throwing, e.g. the failed
+   * parts of the current gtest test for assertion functions using `EXPECT_*`
+   * and `ASSERT_*`. Read before and after each run; a run during which the
+   * count grows fails like a run throwing an exception. A count is used
+   * rather than a flag such as `::testing::Test::HasFailure`, which stays set
+   * after an earlier failure and would mask the failures of later runs.
+   *
+   */
+  std::function<size_t()> failures;
+};
+
 /**
  * @brief Runner Class
  *
@@ -32,6 +148,22 @@ typedef std::function<void(ExecutionContext)> ThreadFunction;
  */
 class Runner {
  public:
+  /**
+   * @brief Construct a new Runner object
+   *
+   * @param options Constant reference to the runner options
+   */
+  explicit Runner(const RunnerOptions &options = RunnerOptions())
+      : event_log(options.log_mode, options.buffer_capacity,
+                  options.timestamps),
+        pool(options.reuse_threads ? new WorkerPool() : nullptr),
+        scheduler(nullptr),
+        pinned(false),
+        iteration(0),
+        deadline(options.deadline),
+        deadline_action(options.deadline_action),
+        finished_capacity(0) {}
+
   /**
    * @brief Access thread function method
    *
@@ -53,9 +185,93 @@ class Runner {
    * @returns `1` if an assertion function is removed else `0`
    */
   size_t Remove(ThreadName &&thread_name) {
+    replicas.erase(thread_name);
+    placements.erase(thread_name);
     return thread_functions.erase(thread_name);
   }
 
+  /**
+   * @brief Access a replicated thread function.
+   *
+   * The thread function with given name is executed by the given number of
+   * threads. The replicas are named `<thread_name>#<index>` and get their
+   * index through `ExecutionContext::GetReplicaIndex`. As for `operator[]`, a
+   * new function is inserted if none exists.
+   *
+   * @param thread_name Rvalue reference to thread name
+   * @param count Number of replicas
+   * @returns Reference to thread function
+   */
+  ThreadFunction &Replicate(ThreadName &&thread_name, size_t count) {
+    replicas[thread_name] = count;
+    return thread_functions[thread_name];
+  }
+
+  /**
+   * @brief Get number of threads executing the registered thread functions,
+   * counting each replica.
+   *
+   */
+  size_t GetThreadCount() const {
+    size_t count = thread_functions.size();
+    for (const auto &element : replicas) {
+      count += element.second - 1;
+    }
+    return count;
+  }
+
+  /**
+   * @brief Get the groups of interchangeable threads formed by the replicas of
+   * each replicated thread function. Pass them to the assertor to treat the
+   * replicas symmetrically.
+   *
+   * @returns Symmetry groups
+   */
+  SymmetryGroups GetSymmetry() const {
+    SymmetryGroups symmetry;
+    for (const auto &element : replicas) {
+      std::vector<ThreadName> thread_names;
+      for (size_t i = 0; i < element.second; ++i) {
+        thread_names.push_back(GetReplicaName(element.first, i));
+      }
+      symmetry.Add(thread_names);
+    }
+    return symmetry;
+  }
+
+  /**
+   * @brief Restrict the threads of subsequent runs to the given CPUs.
+   *
+   * @param cpus CPU identifiers, all available CPUs if empty
+   */
+  void SetAffinity(std::vector<CpuId> cpus) {
+    this->cpus = std::move(cpus);
+    pinned = true;
+    planner.reset();
+  }
+
+  /**
+   * @brief Place the threads of a thread function, including all its
+   * replicas, onto CPUs according to the given policy in subsequent runs. The
+   * CPUs are chosen among the ones the runner is restricted to.
+   *
+   * @param thread_name Rvalue reference to thread name
+   * @param placement Constant reference to the placement
+   */
+  void SetPlacement(ThreadName &&thread_name, const Placement &placement) {
+    placements[thread_name] = placement;
+  }
+
+  /**
+   * @brief Get the CPUs the placed threads of the last run were pinned to.
+   *
+   * @returns Constant reference to the mapping between the names of the
+   * placed threads and their CPUs
+   */
+  const std::unordered_map<ThreadName, CpuInfo> &GetPlacement() const {
+    return placement;
+  }
+
   /**
    * @brief Get the event log object.
    *
@@ -64,28 +280,432 @@ class Runner {
   const EventLog &GetEventLog() const { return event_log; }
 
   /**
-   * @brief Run all registered thread functions.
+   * @brief Get the spread between the earliest and the latest start of a
+   * thread function in the last run. The thread functions are released
+   * together by a barrier, so a spread well below the duration of the thread
+   * functions shows that they overlapped.
+   *
+   * @returns Spread in nanoseconds, zero if less than two threads ran
+   */
+  double GetStartSpread() const {
+    if (start_times.size() < 2) {
+      return 0;
+    }
+    auto range = std::minmax_element(start_times.begin(), start_times.end());
+    return Clock::ToNanoseconds(*range.second - *range.first);
+  }
+
+  /**
+   * @brief Add a listener notified of the events logged by subsequent runs,
+   * e.g. a `TraceWriter` persisting the events.
+   *
+   * @param listener Pointer to the listener
+   */
+  void AddListener(EventListener *listener) { event_log.AddListener(listener); }
+
+  /**
+   * @brief Remove a previously added listener.
+   *
+   * @param listener Pointer to the listener
+   */
+  void RemoveListener(EventListener *listener) {
+    event_log.RemoveListener(listener);
+  }
+
+  /**
+   * @brief Run all registered thread functions. The thread functions are
+   * released together once all their threads are ready. Once all the threads
+   * are joined the event log is sealed. It is unsealed again by the next run.
+   * An exception is thrown if the run was cancelled by its deadline.
    *
    */
   void Run() {
-    // Using a map of threads. Could also have used a list or vector
-    std::unordered_map<ThreadName, std::thread> threads;
+    if (pool) {
+      // Start each iteration from an empty log without reallocating
+      event_log.Clear();
+    } else {
+      // Reopen the log sealed or cancelled by a previous run
+      event_log.Unseal();
+      event_log.ResetCancel();
+    }
 
-    // Create execution context and run all thread functions
+    // Create an execution context for each thread function
+    contexts.clear();
+    functions.clear();
+    thread_cpus.clear();
+    thread_names.clear();
+    placement.clear();
+    if (!placements.empty()) {
+      if (!planner) {
+        planner.reset(new PlacementPlanner(
+            pinned && !cpus.empty() ? QueryCpuTopology(cpus)
+                                    : GetCpuTopology()));
+      }
+      planner->Start(iteration);
+    }
+    ++iteration;
+    start_times.assign(GetThreadCount(), 0);
+    barrier.Reset(GetThreadCount());
+    if (GetThreadCount() > finished_capacity) {
+      finished_capacity = GetThreadCount();
+      finished.reset(new std::atomic<bool>[finished_capacity]);
+    }
+    for (size_t i = 0; i < GetThreadCount(); ++i) {
+      finished[i].store(false, std::memory_order_relaxed);
+    }
     for (auto &element : thread_functions) {
-      // Create an execution context
-      ExecutionContext context(&event_log, element.first);
-      // Spawn thread executing a thread function
-      threads[element.first] = std::thread(element.second, context);
+      auto found = placements.find(element.first);
+      const Placement *thread_placement =
+          found == placements.end() ? nullptr : &found->second;
+      auto replica = replicas.find(element.first);
+      if (replica == replicas.end()) {
+        AddContext(element.first, 0, element.second, thread_placement);
+        continue;
+      }
+      for (size_t i = 0; i < replica->second; ++i) {
+        AddContext(GetReplicaName(element.first, i), i, element.second,
+                   thread_placement);
+      }
+    }
+    if (scheduler != nullptr) {
+      scheduler->Start(&event_log, contexts.size());
+    }
+    if (deadline > std::chrono::milliseconds::zero()) {
+      watchdog.Arm(deadline, deadline_action, &event_log,
+                   [this]() { return DescribeHang(); });
     }
 
-    // Wait for threads to finish
-    for (auto &element : threads) {
-      element.second.join();
+    if (pool) {
+      // Release the parked workers and wait for them to finish
+      pool->Run(contexts.size(), [this](size_t index) {
+        Execute(index);
+      });
+    } else {
+      // Spawn threads executing the thread functions and wait for them
+      std::vector<std::thread> threads;
+      threads.reserve(contexts.size());
+      for (size_t i = 0; i < contexts.size(); ++i) {
+        threads.emplace_back(&Runner::Execute, this, i);
+      }
+      for (auto &thread : threads) {
+        thread.join();
+      }
+    }
+
+    bool hung = deadline > std::chrono::milliseconds::zero() &&
+                watchdog.Disarm();
+
+    // Merge per-thread buffers into the chronologically ordered log
+    if (event_log.GetMode() == EventLog::Mode::BUFFERED) {
+      event_log.Merge();
+    }
+
+    // No writers remain so the log can be handed out as read-only view
+    event_log.Seal();
+
+    if (hung) {
+      throw RunTimedOut(watchdog.GetReport().ToString());
     }
   }
 
+  /**
+   * @brief Run all registered thread functions on a cleared event log and
+   * assert the outcome using the given assertor.
+   *
+   * The observed events are matched against the dispatch table of the
+   * assertor while they are logged. The run is cancelled as soon as no event
+   * list in the table can match, in which case the assertion reports the
+   * observed prefix. Matching happens as events are pushed only in the SHARED
+   * log mode; in the BUFFERED mode it happens when the buffers are merged.
+   *
+   * @param assertor Constant reference to the assertor
+   */
+  void Run(const Assertor &assertor) {
+    StreamingMatcher matcher(assertor);
+
+    event_log.Clear();
+    event_log.AddListener(&matcher);
+    try {
+      Run();
+    } catch (...) {
+      event_log.RemoveListener(&matcher);
+      throw;
+    }
+    event_log.RemoveListener(&matcher);
+
+    assertor.Assert(event_log);
+  }
+
+  /**
+   * @brief Run all registered thread functions under the control of the given
+   * scheduler. Each logged event is a scheduling point at which the scheduler
+   * decides which thread proceeds, so that the order of the events is
+   * determined by the scheduling policy.
+   *
+   * @param scheduler Reference to the scheduler
+   */
+  void Run(Scheduler &scheduler) {
+    this->scheduler = &scheduler;
+    try {
+      Run();
+    } catch (...) {
+      this->scheduler = nullptr;
+      throw;
+    }
+    this->scheduler = nullptr;
+  }
+
+  /**
+   * @brief Run all registered thread functions on a cleared event log forcing
+   * the given schedule.
+   *
+   * @param schedule Constant reference to the schedule
+   * @returns `true` if the threads logged exactly the events of the schedule
+   * else `false`
+   */
+  bool RunSchedule(const EventList &schedule) {
+    ReplayScheduler replay(schedule);
+    event_log.Clear();
+    Run(replay);
+    return replay.IsReplayed();
+  }
+
+  /**
+   * @brief Run each of the given schedules exactly once and assert the outcome
+   * using the given assertor. An exception is thrown if a schedule cannot be
+   * forced.
+   *
+   * @param schedules Constant reference to the schedules
+   * @param assertor Constant reference to the assertor
+   * @returns Number of schedules run
+   */
+  size_t RunAllSchedules(const std::vector<EventList> &schedules,
+                         const Assertor &assertor) {
+    for (const auto &schedule : schedules) {
+      if (!RunSchedule(schedule)) {
+        throw ScheduleDiverged(schedule);
+      }
+      assertor.Assert(event_log);
+    }
+    return schedules.size();
+  }
+
+  /**
+   * @brief Run every schedule of the registered thread functions exactly once
+   * and assert the outcome using the given assertor. The events of each thread
+   * are discovered by running the threads one after another, and all their
+   * interleavings are enumerated one at a time using a `ScheduleEnumerator`.
+   *
+   * Replicas of a replicated thread function are interchangeable, so only the
+   * schedules in canonical form are run. The assertor should be given the
+   * symmetry groups of the runner.
+   *
+   * @note The thread functions are expected to log the same events in every
+   * schedule.
+   *
+   * @param assertor Constant reference to the assertor
+   * @returns Number of schedules run
+   */
+  size_t RunAllSchedules(const Assertor &assertor) {
+    return RunAllSchedules(assertor, ScheduleOptions()).explored;
+  }
+
+  /**
+   * @brief Run the schedules of the registered thread functions, reduced
+   * according to the given options, exactly once and assert the outcome using
+   * the given assertor. With independent operations declared, one schedule of
+   * each Mazurkiewicz trace is run, so the assertor only needs to hold these
+   * representatives. Symmetry groups in the options replace those of the
+   * runner. Otherwise the same as `RunAllSchedules(assertor)`.
+   *
+   * @param assertor Constant reference to the assertor
+   * @param options Constant reference to the schedule options
+   * @returns Report of the number of schedules run out of all schedules
+   */
+  ReductionReport RunAllSchedules(const Assertor &assertor,
+                                  const ScheduleOptions &options) {
+    SequentialScheduler sequential;
+    event_log.Clear();
+    Run(sequential);
+    ScheduleOptions reduced = options;
+    if (reduced.symmetry.Empty()) {
+      reduced.symmetry = GetSymmetry();
+    }
+    ScheduleEnumerator enumerator(event_log.View(), reduced);
+    ReductionReport report;
+    while (enumerator.Next()) {
+      const EventList &schedule = enumerator.Get();
+      if (!RunSchedule(schedule)) {
+        throw ScheduleDiverged(schedule);
+      }
+      assertor.Assert(event_log);
+      ++report.explored;
+    }
+    report.total = enumerator.GetReport().total;
+    report.blocked = enumerator.GetReport().blocked;
+    return report;
+  }
+
+  /**
+   * @brief Run the registered thread functions repeatedly under randomized
+   * priority schedules and assert the outcome of each run using the given
+   * assertor. The number of events per run is measured by running the threads
+   * one after another first. An exception carrying the seed of the failed run
+   * is thrown if a run cannot be asserted, or if the failure counter of the
+   * options grows during the run. The failed run is reproduced by calling the method
+   * again with that seed and a single iteration. The seed of each run is
+   * passed to the listener of the options; the seed of run `k` is also given
+   * by `GetRunSeed(first, k)`.
+   *
+   * @param assertor Constant reference to the assertor
+   * @param options Constant reference to the PCT options
+   * @returns Seed of the first run
+   */
+  uint64_t RunPCT(const Assertor &assertor,
+                  const PCTOptions &options = PCTOptions()) {
+    uint64_t seed = options.seed;
+    while (seed == 0) {
+      std::random_device device;
+      seed = (static_cast<uint64_t>(device()) << 32) | device();
+    }
+    SequentialScheduler sequential;
+    event_log.Clear();
+    Run(sequential);
+    PCTScheduler pct(seed, options.change_points, event_log.Size());
+    for (size_t i = 0; i < options.iterations; ++i) {
+      if (options.listener) {
+        options.listener(pct.GetSeed(), i);
+      }
+      // Only failures reported by the run itself count
+      size_t failures = options.failures ? options.failures() : 0;
+      event_log.Clear();
+      try {
+        Run(pct);
+        assertor.Assert(event_log);
+      } catch (const std::exception &error) {
+        throw SeededRunFailed(pct.GetSeed(), error.what());
+      }
+      if (options.failures && options.failures() > failures) {
+        throw SeededRunFailed(pct.GetSeed(), "failure reported by the run");
+      }
+      pct.SetSeed(NextSeed(pct.GetSeed()));
+    }
+    return seed;
+  }
+
+  /**
+   * @brief Repeat the registered thread functions on a cleared event log until
+   * a stopping criterion of the given options is met, and report the
+   * frequency of each observed schedule.
+   *
+   * @param options Constant reference to the coverage options
+   * @returns Coverage report
+   */
+  CoverageReport RunUntilCoverage(
+      const CoverageOptions &options = CoverageOptions()) {
+    CoverageTracker tracker(options, nullptr);
+    do {
+      event_log.Clear();
+      Run();
+      tracker.Add(event_log.View());
+    } while (!tracker.Done());
+    return tracker.GetReport();
+  }
+
+  /**
+   * @brief Repeat the registered thread functions and assert the outcome of
+   * each iteration using the given assertor, until a stopping criterion of
+   * the given options is met or every event list in the dispatch table of the
+   * assertor has been observed.
+   *
+   * @param assertor Constant reference to the assertor
+   * @param options Constant reference to the coverage options
+   * @returns Coverage report
+   */
+  CoverageReport RunUntilCoverage(
+      const Assertor &assertor,
+      const CoverageOptions &options = CoverageOptions()) {
+    CoverageTracker tracker(options, &assertor);
+    do {
+      Run(assertor);
+      tracker.Add(event_log.View());
+    } while (!tracker.Done());
+    return tracker.GetReport();
+  }
+
   TSTEST_PRIVATE
+  /**
+   * @brief Create the execution context of a thread of the current run and
+   * place the thread if it has a placement.
+   *
+   */
+  void AddContext(const ThreadName &thread_name, size_t replica_index,
+                  const ThreadFunction &thread_function,
+                  const Placement *thread_placement) {
+    size_t index = contexts.size();
+    contexts.push_back(event_log.GetMode() == EventLog::Mode::BUFFERED
+                           ? ExecutionContext(&event_log,
+                                              event_log.CreateBuffer(),
+                                              thread_name, scheduler, index,
+                                              replica_index)
+                           : ExecutionContext(&event_log, thread_name,
+                                              scheduler, index,
+                                              replica_index));
+    functions.push_back(&thread_function);
+    thread_names.push_back(thread_name);
+    thread_cpus.push_back(nullptr);
+    if (thread_placement != nullptr) {
+      thread_cpus.back() = &planner->Place(*thread_placement);
+      placement[thread_name] = *thread_cpus.back();
+    }
+  }
+
+  /**
+   * @brief Execute a thread function of the current run once all threads of
+   * the run are ready. The function stops early if the run is cancelled.
+   *
+   * @param index Index of the thread function and its context
+   */
+  void Execute(size_t index) {
+    if (thread_cpus[index] != nullptr) {
+      SetThreadAffinity({thread_cpus[index]->id});
+    } else if (pinned || !placements.empty()) {
+      // Undo the placement of a reused worker thread
+      SetThreadAffinity(cpus);
+    }
+    barrier.Wait();
+    start_times[index] = Clock::Now();
+    if (scheduler != nullptr) {
+      scheduler->Enter(index);
+    }
+    try {
+      (*functions[index])(contexts[index]);
+    } catch (const RunCancelled &) {
+      // Run cancelled: stop executing the thread function
+    }
+    if (scheduler != nullptr) {
+      scheduler->Finish(index);
+    }
+    finished[index].store(true, std::memory_order_release);
+  }
+
+  /**
+   * @brief Describe the current run for the watchdog. Called on the monitor
+   * thread while the run is in progress.
+   *
+   */
+  HangReport DescribeHang() const {
+    HangReport report;
+    for (size_t i = 0; i < thread_names.size(); ++i) {
+      if (!finished[i].load(std::memory_order_acquire)) {
+        report.unfinished.push_back(thread_names[i]);
+      }
+    }
+    report.open = FindOpenOperations(event_log.Snapshot());
+    report.last = event_log.Snapshot(HangReport::kLastEvents);
+    return report;
+  }
+
   /**
    * @brief Chronologically ordered log of events.
    *
@@ -96,6 +716,112 @@ class Runner {
    *
    */
   std::unordered_map<ThreadName, ThreadFunction> thread_functions;
+  /**
+   * @brief Mapping between names of replicated thread functions and their
+   * number of replicas.
+   *
+   */
+  std::unordered_map<ThreadName, size_t> replicas;
+  /**
+   * @brief Persistent worker threads, null unless threads are reused.
+   *
+   */
+  std::unique_ptr<WorkerPool> pool;
+  /**
+   * @brief Execution contexts of the current run.
+   *
+   */
+  std::vector<ExecutionContext> contexts;
+  /**
+   * @brief Thread functions of the current run in the order of the contexts.
+   *
+   */
+  std::vector<const ThreadFunction *> functions;
+  /**
+   * @brief Barrier releasing the thread functions of a run together.
+   *
+   */
+  SpinBarrier barrier;
+  /**
+   * @brief Timestamps at which the thread functions of the last run started.
+   *
+   */
+  std::vector<Timestamp> start_times;
+  /**
+   * @brief Scheduler controlling the current run, null if threads run freely.
+   *
+   */
+  Scheduler *scheduler;
+  /**
+   * @brief CPUs the threads of a run are restricted to, all if empty.
+   *
+   */
+  std::vector<CpuId> cpus;
+  /**
+   * @brief Flag indicating that the threads should set their affinity.
+   *
+   */
+  bool pinned;
+  /**
+   * @brief Mapping between names of thread functions and their placements.
+   *
+   */
+  std::unordered_map<ThreadName, Placement> placements;
+  /**
+   * @brief Planner placing threads onto the CPUs of the runner, created on
+   * first use.
+   *
+   */
+  std::unique_ptr<PlacementPlanner> planner;
+  /**
+   * @brief CPUs of the placed threads of the current run in the order of the
+   * contexts, null for threads without placement.
+   *
+   */
+  std::vector<const CpuInfo *> thread_cpus;
+  /**
+   * @brief Mapping between names of the placed threads of the last run and
+   * their CPUs.
+   *
+   */
+  std::unordered_map<ThreadName, CpuInfo> placement;
+  /**
+   * @brief Number of runs started.
+   *
+   */
+  size_t iteration;
+  /**
+   * @brief Names of the threads of the current run in the order of the
+   * contexts.
+   *
+   */
+  std::vector<ThreadName> thread_names;
+  /**
+   * @brief Time a run is allowed to take, no deadline if zero.
+   *
+   */
+  std::chrono::milliseconds deadline;
+  /**
+   * @brief Action taken when the deadline of a run expires.
+   *
+   */
+  Watchdog::Action deadline_action;
+  /**
+   * @brief Monitor of the run deadlines.
+   *
+   */
+  Watchdog watchdog;
+  /**
+   * @brief Flags indicating the threads of the current run which returned
+   * from their thread function, in the order of the contexts.
+   *
+   */
+  std::unique_ptr<std::atomic<bool>[]> finished;
+  /**
+   * @brief Number of allocated flags.
+   *
+   */
+  size_t finished_capacity;
 };
 
 }  // namespace details
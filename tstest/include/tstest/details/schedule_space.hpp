@@ -0,0 +1,303 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#ifndef TSTEST__DETAILS__SCHEDULE_SPACE_HPP
+#define TSTEST__DETAILS__SCHEDULE_SPACE_HPP
+
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include <tstest/details/defs.hpp>
+#include <tstest/details/event.hpp>
+#include <tstest/details/exception.hpp>
+
+namespace tstest {
+namespace details {
+
+/**
+ * @brief Split a list of events into the event sequences of its threads. The
+ * threads are numbered in the order of their first event.
+ *
+ * @param event_list Constant reference to the list of events
+ * @returns Events of each thread in order
+ */
+inline std::vector<std::vector<Event>> SplitThreads(
+    const EventList &event_list) {
+  std::vector<std::vector<Event>> threads;
+  std::unordered_map<SymbolId, size_t> numbers;
+  for (const auto &event : event_list) {
+    auto it = numbers.emplace(event.GetThreadId(), threads.size()).first;
+    if (it->second == threads.size()) {
+      threads.emplace_back();
+    }
+    threads[it->second].push_back(event);
+  }
+  return threads;
+}
+
+/**
+ * @brief Schedule Space Class
+ *
+ * Closed-form view of the schedules of a list of events, i.e. the
+ * interleavings of its per-thread event sequences. The schedules are counted
+ * with the multinomial coefficient `n! / (n_1! * ... * n_k!)` and numbered by
+ * their rank in the enumeration order of `GetAllSchedules`, so that any
+ * schedule can be addressed, stored or sampled as a single integer and the
+ * enumeration can be sharded by rank ranges. Counts above `UINT64_MAX` are
+ * detected and reported by an exception.
+ *
+ */
+class ScheduleSpace {
+ public:
+  /**
+   * @brief Construct a new Schedule Space object
+   *
+   * @param event_list Constant reference to the list of events
+   */
+  explicit ScheduleSpace(const EventList &event_list)
+      : threads(SplitThreads(event_list)), length(event_list.size()) {
+    for (size_t i = 0; i < threads.size(); ++i) {
+      numbers[threads[i].front().GetThreadId()] = i;
+    }
+  }
+
+  /**
+   * @brief Compute the multinomial coefficient of the given counts.
+   *
+   * @param counts Constant reference to the counts
+   * @param result Reference to the coefficient, set only without overflow
+   * @returns `true` if the coefficient fits into 64 bits else `false`
+   */
+  static bool Multinomial(const std::vector<size_t> &counts,
+                          uint64_t &result) {
+    uint64_t count = 1;
+    uint64_t total = 0;
+    for (auto k : counts) {
+      // Multiply by the binomial coefficient (total + k choose k)
+      for (uint64_t i = 1; i <= k; ++i) {
+        ++total;
+        // count * total / i is an integer and i / gcd(count, i) divides total
+        uint64_t common = Gcd(count, i);
+        uint64_t factor = total / (i / common);
+        count /= common;
+        if (count > UINT64_MAX / factor) {
+          return false;
+        }
+        count *= factor;
+      }
+    }
+    result = count;
+    return true;
+  }
+
+  /**
+   * @brief Get the number of schedules. An exception is thrown if the number
+   * does not fit into 64 bits.
+   *
+   */
+  uint64_t Count() const { return Count(GetCounts()); }
+
+  /**
+   * @brief Get the thread sequence of the schedule with the given rank. An
+   * exception is thrown if the rank is out of range.
+   *
+   * @param rank Rank of the schedule
+   * @returns Thread number of each event of the schedule
+   */
+  std::vector<size_t> UnrankThreads(uint64_t rank) const {
+    std::vector<size_t> counts = GetCounts();
+    uint64_t remaining = Count(counts);
+    if (rank >= remaining) {
+      throw std::out_of_range("Schedule rank out of range");
+    }
+    std::vector<size_t> sequence;
+    sequence.reserve(length);
+    for (size_t left = length; left > 0; --left) {
+      for (size_t thread = 0; thread < counts.size(); ++thread) {
+        if (counts[thread] == 0) {
+          continue;
+        }
+        // Number of schedules continuing with the thread
+        uint64_t below = Fraction(remaining, counts[thread], left);
+        if (rank < below) {
+          sequence.push_back(thread);
+          --counts[thread];
+          remaining = below;
+          break;
+        }
+        rank -= below;
+      }
+    }
+    return sequence;
+  }
+
+  /**
+   * @brief Get the schedule with the given rank. An exception is thrown if
+   * the rank is out of range.
+   *
+   * @param rank Rank of the schedule
+   * @returns Schedule
+   */
+  EventList Unrank(uint64_t rank) const {
+    std::vector<size_t> positions(threads.size(), 0);
+    EventList schedule;
+    schedule.reserve(length);
+    for (auto thread : UnrankThreads(rank)) {
+      schedule.push_back(threads[thread][positions[thread]++]);
+    }
+    return schedule;
+  }
+
+  /**
+   * @brief Get the rank of the schedule with the given thread sequence. An
+   * exception is thrown if the sequence does not describe a schedule.
+   *
+   * @param sequence Constant reference to the thread number of each event
+   * @returns Rank of the schedule
+   */
+  uint64_t Rank(const std::vector<size_t> &sequence) const {
+    std::vector<size_t> counts = GetCounts();
+    uint64_t remaining = Count(counts);
+    if (sequence.size() != length) {
+      throw std::invalid_argument("Not a schedule of the events");
+    }
+    uint64_t rank = 0;
+    size_t left = length;
+    for (auto thread : sequence) {
+      if (thread >= counts.size() || counts[thread] == 0) {
+        throw std::invalid_argument("Not a schedule of the events");
+      }
+      // Skip the schedules continuing with a lower thread
+      for (size_t lower = 0; lower < thread; ++lower) {
+        if (counts[lower] > 0) {
+          rank += Fraction(remaining, counts[lower], left);
+        }
+      }
+      remaining = Fraction(remaining, counts[thread], left);
+      --counts[thread];
+      --left;
+    }
+    return rank;
+  }
+
+  /**
+   * @brief Get the rank of a schedule. An exception is thrown if the events
+   * do not form a schedule.
+   *
+   * @param schedule Constant reference to the schedule
+   * @returns Rank of the schedule
+   */
+  uint64_t Rank(const EventList &schedule) const {
+    std::vector<size_t> positions(threads.size(), 0);
+    std::vector<size_t> sequence;
+    sequence.reserve(schedule.size());
+    for (const auto &event : schedule) {
+      auto it = numbers.find(event.GetThreadId());
+      if (it == numbers.end() ||
+          positions[it->second] == threads[it->second].size() ||
+          threads[it->second][positions[it->second]] != event) {
+        throw std::invalid_argument("Not a schedule of the events");
+      }
+      ++positions[it->second];
+      sequence.push_back(it->second);
+    }
+    return Rank(sequence);
+  }
+
+  /**
+   * @brief Draw a schedule uniformly at random.
+   *
+   * @param random Reference to the random number generator
+   * @returns Schedule
+   */
+  template <typename Random>
+  EventList Sample(Random &random) const {
+    std::uniform_int_distribution<uint64_t> distribution(0, Count() - 1);
+    return Unrank(distribution(random));
+  }
+
+  /**
+   * @brief Get the number of threads.
+   *
+   */
+  size_t GetThreadCount() const { return threads.size(); }
+
+  TSTEST_PRIVATE
+  /**
+   * @brief Get the number of events of each thread.
+   *
+   */
+  std::vector<size_t> GetCounts() const {
+    std::vector<size_t> counts;
+    for (const auto &events : threads) {
+      counts.push_back(events.size());
+    }
+    return counts;
+  }
+
+  /**
+   * @brief Get the multinomial coefficient of the given counts. An exception
+   * is thrown if it does not fit into 64 bits.
+   *
+   */
+  static uint64_t Count(const std::vector<size_t> &counts) {
+    uint64_t count = 0;
+    if (!Multinomial(counts, count)) {
+      throw ScheduleCountOverflow();
+    }
+    return count;
+  }
+
+  /**
+   * @brief Get `count * part / whole` for a multinomial coefficient `count`
+   * of counts summing to `whole`, one of which is `part`. The result is the
+   * coefficient with that count decremented and never overflows.
+   *
+   */
+  static uint64_t Fraction(uint64_t count, uint64_t part, uint64_t whole) {
+    // gcd(part / g, whole / g) = 1 so whole / g divides count
+    uint64_t common = Gcd(part, whole);
+    return count / (whole / common) * (part / common);
+  }
+
+  /**
+   * @brief Get the greatest common divisor of two numbers.
+   *
+   */
+  static uint64_t Gcd(uint64_t a, uint64_t b) {
+    while (b != 0) {
+      uint64_t r = a % b;
+      a = b;
+      b = r;
+    }
+    return a;
+  }
+
+  /**
+   * @brief Events of each thread in order
+   *
+   */
+  std::vector<std::vector<Event>> threads;
+  /**
+   * @brief Mapping between thread identifiers and thread numbers
+   *
+   */
+  std::unordered_map<SymbolId, size_t> numbers;
+  /**
+   * @brief Number of events in a schedule
+   *
+   */
+  size_t length;
+};
+
+}  // namespace details
+}  // namespace tstest
+
+#endif /* TSTEST__DETAILS__SCHEDULE_SPACE_HPP */
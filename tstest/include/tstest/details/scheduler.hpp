@@ -0,0 +1,508 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#ifndef TSTEST__DETAILS__SCHEDULER_HPP
+#define TSTEST__DETAILS__SCHEDULER_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <tstest/details/defs.hpp>
+#include <tstest/details/event.hpp>
+#include <tstest/details/event_log.hpp>
+#include <tstest/details/exception.hpp>
+
+namespace tstest {
+namespace details {
+
+/**
+ * @brief Scheduler Class
+ *
+ * Base class of cooperative schedulers controlling the order in which the
+ * threads of a run log their operation events. Exactly one thread of the run
+ * executes at any time. A thread starts once the threads before it reached
+ * their first scheduling point, and every logged event is a scheduling point
+ * at which the thread announces the event and waits. Once all the unfinished
+ * threads wait, the scheduling policy picks the thread whose announced event
+ * is logged next. A run is thus fully determined by the policy.
+ *
+ * Derived classes implement the policy by overriding `Pick`.
+ *
+ */
+class Scheduler {
+ public:
+  /**
+   * @brief Value returned by `Pick` if no thread can be picked.
+   *
+   */
+  static constexpr size_t npos = SIZE_MAX;
+
+  /**
+   * @brief Construct a new Scheduler object
+   *
+   */
+  Scheduler()
+      : event_log(nullptr), started(0), turn(npos), diverged(false) {}
+
+  Scheduler(const Scheduler &) = delete;
+  Scheduler &operator=(const Scheduler &) = delete;
+
+  /**
+   * @brief Destroy the Scheduler object
+   *
+   */
+  virtual ~Scheduler() = default;
+
+  /**
+   * @brief Prepare the scheduler for a run with the given number of threads.
+   * The first thread gets the turn.
+   *
+   * @note Should only be called when no thread of a previous run is active.
+   *
+   * @param event_log Pointer to the event log of the run, cancelled if the
+   * policy cannot pick a thread
+   * @param thread_count Number of threads in the run
+   */
+  void Start(EventLog *event_log, size_t thread_count) {
+    std::lock_guard<std::mutex> guard(lock);
+    this->event_log = event_log;
+    threads.assign(thread_count, ThreadState());
+    candidates.clear();
+    candidates.reserve(thread_count);
+    started = 0;
+    turn = npos;
+    diverged = false;
+    OnStart(thread_count);
+    Dispatch();
+  }
+
+  /**
+   * @brief Wait until the given thread gets its turn to start.
+   *
+   * @param thread Index of the thread in the run
+   */
+  void Enter(size_t thread) {
+    std::unique_lock<std::mutex> guard(lock);
+    resume.wait(guard, [this, thread]() { return turn == thread; });
+  }
+
+  /**
+   * @brief Announce the next event of a thread and wait until the policy
+   * picks it. An exception is thrown if the run was cancelled because the
+   * policy could not pick any thread.
+   *
+   * @param thread Index of the thread in the run
+   * @param event Constant reference to the event to log next
+   */
+  void Schedule(size_t thread, const Event &event) {
+    std::unique_lock<std::mutex> guard(lock);
+    threads[thread].pending = event;
+    threads[thread].waiting = true;
+    Dispatch();
+    resume.wait(guard, [this, thread]() { return turn == thread; });
+    threads[thread].waiting = false;
+    if (diverged) {
+      throw RunCancelled();
+    }
+  }
+
+  /**
+   * @brief Mark a thread as finished and pass the turn on.
+   *
+   * @param thread Index of the thread in the run
+   */
+  void Finish(size_t thread) {
+    std::lock_guard<std::mutex> guard(lock);
+    threads[thread].finished = true;
+    threads[thread].waiting = false;
+    Dispatch();
+  }
+
+  /**
+   * @brief Check if the policy failed to pick a thread during the last run.
+   *
+   * @returns `true` if the run diverged from the policy else `false`
+   */
+  bool IsDiverged() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return diverged;
+  }
+
+ protected:
+  /**
+   * @brief Called when a run starts.
+   *
+   * @param thread_count Number of threads in the run
+   */
+  virtual void OnStart(size_t /*thread_count*/) {}
+
+  /**
+   * @brief Pick the thread whose announced event is logged next.
+   *
+   * @param candidates Constant reference to the indices of the waiting
+   * threads in increasing order
+   * @returns Index of the picked thread or `npos` if none can be picked
+   */
+  virtual size_t Pick(const std::vector<size_t> &candidates) = 0;
+
+  /**
+   * @brief Get the event announced by a waiting thread.
+   *
+   * @param thread Index of the thread in the run
+   */
+  const Event &GetPending(size_t thread) const {
+    return threads[thread].pending;
+  }
+
+  TSTEST_PRIVATE
+  /**
+   * @brief Per-thread scheduling state
+   *
+   */
+  struct ThreadState {
+    /**
+     * @brief Event announced at the scheduling point the thread waits at
+     *
+     */
+    Event pending;
+    /**
+     * @brief Flag indicating that the thread waits at a scheduling point
+     *
+     */
+    bool waiting = false;
+    /**
+     * @brief Flag indicating that the thread function returned
+     *
+     */
+    bool finished = false;
+  };
+
+  /**
+   * @brief Pass the turn to the next thread. Threads are started in order
+   * before the policy is consulted. Once the policy fails to pick a thread the
+   * run is cancelled and the waiting threads are resumed in order so that
+   * they can unwind.
+   *
+   */
+  void Dispatch() {
+    if (started < threads.size()) {
+      turn = started++;
+      resume.notify_all();
+      return;
+    }
+    candidates.clear();
+    for (size_t i = 0; i < threads.size(); ++i) {
+      if (threads[i].waiting) {
+        candidates.push_back(i);
+      }
+    }
+    turn = npos;
+    if (!candidates.empty()) {
+      if (!diverged && !event_log->IsCancelled()) {
+        turn = Pick(candidates);
+      }
+      if (turn == npos) {
+        if (!diverged && !event_log->IsCancelled()) {
+          diverged = true;
+          event_log->Cancel();
+        }
+        turn = candidates.front();
+      }
+    }
+    resume.notify_all();
+  }
+
+  /**
+   * @brief Lock guarding the scheduling state
+   *
+   */
+  mutable std::mutex lock;
+  /**
+   * @brief Condition signalled when the turn changes
+   *
+   */
+  std::condition_variable resume;
+  /**
+   * @brief Event log of the current run
+   *
+   */
+  EventLog *event_log;
+  /**
+   * @brief Scheduling state of each thread
+   *
+   */
+  std::vector<ThreadState> threads;
+  /**
+   * @brief Scratch vector of waiting threads
+   *
+   */
+  std::vector<size_t> candidates;
+  /**
+   * @brief Number of threads which got their turn to start
+   *
+   */
+  size_t started;
+  /**
+   * @brief Index of the thread allowed to execute
+   *
+   */
+  size_t turn;
+  /**
+   * @brief Flag indicating that the policy failed to pick a thread
+   *
+   */
+  bool diverged;
+};
+
+/**
+ * @brief Sequential Scheduler Class
+ *
+ * Scheduling policy always picking the waiting thread with the lowest index,
+ * so that the threads of a run execute one after another.
+ *
+ */
+class SequentialScheduler : public Scheduler {
+ protected:
+  size_t Pick(const std::vector<size_t> &candidates) override {
+    return candidates.front();
+  }
+};
+
+/**
+ * @brief Replay Scheduler Class
+ *
+ * Scheduling policy replaying a given schedule exactly. The run diverges if
+ * the next event of the schedule is not announced by any waiting thread, or if
+ * the threads announce more events than the schedule contains.
+ *
+ */
+class ReplayScheduler : public Scheduler {
+ public:
+  /**
+   * @brief Construct a new Replay Scheduler object
+   *
+   * @param schedule Constant reference to the schedule to replay
+   */
+  explicit ReplayScheduler(const EventList &schedule)
+      : schedule(schedule), position(0) {}
+
+  /**
+   * @brief Check if the last run logged exactly the events of the schedule.
+   *
+   * @returns `true` if the schedule was replayed else `false`
+   */
+  bool IsReplayed() const {
+    return !IsDiverged() && position == schedule.size();
+  }
+
+ protected:
+  void OnStart(size_t /*thread_count*/) override { position = 0; }
+
+  size_t Pick(const std::vector<size_t> &candidates) override {
+    if (position == schedule.size()) {
+      return npos;
+    }
+    Event next = schedule[position];
+    for (auto thread : candidates) {
+      if (GetPending(thread) == next) {
+        ++position;
+        return thread;
+      }
+    }
+    return npos;
+  }
+
+  TSTEST_PRIVATE
+  /**
+   * @brief Schedule to replay
+   *
+   */
+  const EventList &schedule;
+  /**
+   * @brief Position of the next event to replay
+   *
+   */
+  size_t position;
+};
+
+/**
+ * @brief Compute the seed following the given one. Used to derive the seeds of
+ * consecutive randomized runs from a single seed.
+ *
+ * @param seed Seed
+ * @returns Next seed
+ */
+inline uint64_t NextSeed(uint64_t seed) {
+  // SplitMix64 step
+  uint64_t z = seed + 0x9E3779B97F4A7C15ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+/**
+ * @brief Get the seed of a run of consecutive randomized runs.
+ *
+ * @param seed Seed of the first run
+ * @param iteration Index of the run
+ * @returns Seed of the run
+ */
+inline uint64_t GetRunSeed(uint64_t seed, size_t iteration) {
+  for (size_t i = 0; i < iteration; ++i) {
+    seed = NextSeed(seed);
+  }
+  return seed;
+}
+
+/**
+ * @brief Draw a number uniformly from [0, bound) using the raw output of a
+ * 64-bit Mersenne Twister. Unlike `std::uniform_int_distribution`, whose
+ * algorithm is left to the implementation, the draw only depends on the
+ * generator output, which the standard fixes for a given seed.
+ *
+ * @param random Reference to the random number generator
+ * @param bound Exclusive upper bound, greater than zero
+ * @returns Random number
+ */
+inline uint64_t DrawBelow(std::mt19937_64 &random, uint64_t bound) {
+  // Reject the lowest 2^64 mod bound outputs which would bias the remainder
+  uint64_t threshold = (0 - bound) % bound;
+  while (true) {
+    uint64_t value = random();
+    if (value >= threshold) {
+      return value % bound;
+    }
+  }
+}
+
+/**
+ * @brief PCT Scheduler Class
+ *
+ * Probabilistic concurrency testing policy. At the start of a run the threads
+ * get distinct random priorities and `d` random steps are chosen as priority
+ * change points, where a step is the logging of one event. The waiting thread
+ * with the highest priority is always picked. When the i-th change point is
+ * reached, the priority of the picked thread drops below all initial
+ * priorities to `i` and the pick is repeated. For a run of `n` threads logging
+ * `k` events, a bug of depth `d + 1` is found with probability at least
+ * `1 / (n * k^d)`.
+ *
+ * A run is fully determined by its 64-bit seed. The random draws are computed
+ * from the raw output of `std::mt19937_64`, so a seed gives the same run with
+ * every standard library.
+ *
+ */
+class PCTScheduler : public Scheduler {
+ public:
+  /**
+   * @brief Construct a new PCT Scheduler object
+   *
+   * @param seed Seed of the next run
+   * @param change_points Number of priority change points `d`
+   * @param steps Expected number of events logged in a run `k`
+   */
+  PCTScheduler(uint64_t seed, size_t change_points, size_t steps)
+      : seed(seed), change_points(change_points), steps(steps), step(0) {}
+
+  /**
+   * @brief Set the seed of the next run.
+   *
+   */
+  void SetSeed(uint64_t seed) { this->seed = seed; }
+
+  /**
+   * @brief Get the seed of the next or current run.
+   *
+   */
+  uint64_t GetSeed() const { return seed; }
+
+ protected:
+  void OnStart(size_t thread_count) override {
+    std::mt19937_64 random(seed);
+    // Initial priorities above the ones assigned at change points
+    priorities.resize(thread_count);
+    std::iota(priorities.begin(), priorities.end(), change_points + 1);
+    // Fisher-Yates shuffle
+    for (size_t i = priorities.size(); i > 1; --i) {
+      std::swap(priorities[i - 1], priorities[DrawBelow(random, i)]);
+    }
+    // Change points drawn from the steps [1, k]
+    changes.clear();
+    for (size_t i = 0; i < change_points; ++i) {
+      changes.push_back(1 + DrawBelow(random, std::max<size_t>(1, steps)));
+    }
+    std::sort(changes.begin(), changes.end());
+    step = 0;
+  }
+
+  size_t Pick(const std::vector<size_t> &candidates) override {
+    ++step;
+    size_t thread = Highest(candidates);
+    // Lower the priority of the picked thread at each change point reached
+    for (size_t i = 0; i < changes.size(); ++i) {
+      if (changes[i] == step) {
+        priorities[thread] = i + 1;
+        thread = Highest(candidates);
+      }
+    }
+    return thread;
+  }
+
+  TSTEST_PRIVATE
+  /**
+   * @brief Get the candidate with the highest priority.
+   *
+   */
+  size_t Highest(const std::vector<size_t> &candidates) const {
+    return *std::max_element(candidates.begin(), candidates.end(),
+                             [this](size_t a, size_t b) {
+                               return priorities[a] < priorities[b];
+                             });
+  }
+
+  /**
+   * @brief Seed of the next or current run
+   *
+   */
+  uint64_t seed;
+  /**
+   * @brief Number of priority change points
+   *
+   */
+  size_t change_points;
+  /**
+   * @brief Expected number of events logged in a run
+   *
+   */
+  size_t steps;
+  /**
+   * @brief Number of events picked in the current run
+   *
+   */
+  size_t step;
+  /**
+   * @brief Priority of each thread
+   *
+   */
+  std::vector<size_t> priorities;
+  /**
+   * @brief Steps at which priorities change in increasing order
+   *
+   */
+  std::vector<size_t> changes;
+};
+
+}  // namespace details
+}  // namespace tstest
+
+#endif /* TSTEST__DETAILS__SCHEDULER_HPP */
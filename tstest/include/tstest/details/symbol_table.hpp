@@ -0,0 +1,207 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#ifndef TSTEST__DETAILS__SYMBOL_TABLE_HPP
+#define TSTEST__DETAILS__SYMBOL_TABLE_HPP
+
+#include <cstdint>
+#include <exception>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+#include <tstest/details/annotations.hpp>
+#include <tstest/details/defs.hpp>
+#include <tstest/details/mutex.hpp>
+
+namespace tstest {
+namespace details {
+
+/**
+ * @brief Symbol identifier type
+ *
+ * Compact integer identifier of an interned thread or operation name.
+ *
+ */
+typedef uint32_t SymbolId;
+
+/**
+ * @brief Compute the identifier of a symbol name.
+ *
+ * The identifier is the 32-bit FNV-1a hash of the name. It is deterministic
+ * across runs and can be evaluated at compile time.
+ *
+ * @param name Pointer to the characters of the name
+ * @param size Number of characters in the name
+ * @returns Symbol identifier
+ */
+constexpr SymbolId HashSymbol(const char *name, size_t size) {
+  SymbolId hash = 2166136261U;
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= static_cast<uint8_t>(name[i]);
+    hash *= 16777619U;
+  }
+  return hash;
+}
+
+/**
+ * @brief Compute the identifier of a symbol name given as a string literal.
+ *
+ * @param name Constant reference to the character array of the name
+ * @returns Symbol identifier
+ */
+template <size_t N>
+constexpr SymbolId HashSymbol(const char (&name)[N]) {
+  return HashSymbol(name, N - 1);
+}
+
+/**
+ * Symbol Collision Error
+ *
+ * This error is thrown if two different names hash to the same symbol
+ * identifier.
+ */
+class SymbolCollision : public std::exception {
+ private:
+  std::string msg;
+
+ public:
+  SymbolCollision(const std::string &name, const std::string &other)
+      : msg("Symbol name \"" + name + "\" collides with \"" + other + "\"") {}
+
+  const char *what() const throw() { return msg.c_str(); }
+};
+
+/**
+ * @brief Symbol Table Class
+ *
+ * The symbol table interns thread and operation names and hands out compact
+ * integer identifiers for them. Events store only the identifiers, which are
+ * resolved back to names when needed, e.g. for printing. Interning an already
+ * known name does not allocate any memory.
+ *
+ * @note A single process wide table is used so that identifiers are shared by
+ * all event logs, assertors and runners.
+ *
+ */
+class SymbolTable {
+  TSTEST_PRIVATE
+  /**
+   * @brief Readers-writer lock for mutual exclusion
+   *
+   */
+  typedef typename tstest::details::SharedMutex<std::shared_timed_mutex>
+      Mutex;
+  mutable Mutex lock;  //<- lock for achieving thread safety
+  typedef typename tstest::details::LockGuard<Mutex> LockGuard;
+  typedef typename tstest::details::SharedLock<Mutex> SharedLock;
+
+  /**
+   * @brief Mapping between symbol identifiers and names.
+   *
+   */
+  std::unordered_map<SymbolId, std::string> names GUARDED_BY(lock);
+
+ public:
+  /**
+   * @brief Get the process wide symbol table.
+   *
+   * @thread_safe
+   *
+   * @returns Reference to the symbol table
+   */
+  static SymbolTable &Instance() {
+    static SymbolTable instance;
+    return instance;
+  }
+
+  /**
+   * @brief Intern a name and get its identifier. An exception is thrown if
+   * the name collides with a different name already in the table.
+   *
+   * @thread_safe
+   *
+   * @param name Constant reference to the name to intern
+   * @returns Symbol identifier of the name
+   */
+  SymbolId Intern(const std::string &name) {
+    SymbolId id = HashSymbol(name.data(), name.size());
+    {
+      SharedLock guard(lock);
+
+      auto it = names.find(id);
+      if (it != names.end()) {
+        if (it->second != name) {
+          throw SymbolCollision(name, it->second);
+        }
+        return id;
+      }
+    }
+    LockGuard guard(lock);
+
+    auto it = names.emplace(id, name).first;
+    if (it->second != name) {
+      throw SymbolCollision(name, it->second);
+    }
+    return id;
+  }
+
+  /**
+   * @brief Resolve a symbol identifier back to its name. An exception of type
+   * `std::out_of_range` is thrown if the identifier was never interned.
+   *
+   * @thread_safe
+   *
+   * @param id Symbol identifier
+   * @returns Constant reference to the interned name
+   */
+  const std::string &Resolve(SymbolId id) const {
+    SharedLock guard(lock);
+
+    return names.at(id);
+  }
+
+  /**
+   * @brief Get number of interned symbols.
+   *
+   * @thread_safe
+   *
+   * @returns Number of symbols in the table
+   */
+  size_t Size() const {
+    SharedLock guard(lock);
+
+    return names.size();
+  }
+};
+
+}  // namespace details
+}  // namespace tstest
+
+/**
+ * @brief Macro to get the symbol identifier of a string literal.
+ *
+ * The identifier is computed at compile time. The name is interned in the
+ * symbol table only on the first evaluation at each call site, so subsequent
+ * evaluations do not perform any string operations.
+ *
+ * @example
+ *
+ *  SymbolId id = TSTEST_SYMBOL_ID("example-operation");
+ *
+ */
+#define TSTEST_SYMBOL_ID(Name)                                            \
+  ([]() -> ::tstest::details::SymbolId {                                  \
+    constexpr ::tstest::details::SymbolId id =                            \
+        ::tstest::details::HashSymbol(Name);                              \
+    static const ::tstest::details::SymbolId interned =                   \
+        ::tstest::details::SymbolTable::Instance().Intern(Name);          \
+    (void)interned;                                                       \
+    return id;                                                            \
+  }())
+
+#endif /* TSTEST__DETAILS__SYMBOL_TABLE_HPP */
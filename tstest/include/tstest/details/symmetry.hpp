@@ -0,0 +1,217 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#ifndef TSTEST__DETAILS__SYMMETRY_HPP
+#define TSTEST__DETAILS__SYMMETRY_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <tstest/details/event.hpp>
+#include <tstest/details/symbol_table.hpp>
+
+namespace tstest {
+namespace details {
+
+/**
+ * @brief Get the thread name of a replica of a replicated thread function.
+ *
+ * @param thread_name Constant reference to the name of the thread function
+ * @param index Index of the replica
+ * @returns Thread name of the replica
+ */
+inline ThreadName GetReplicaName(const ThreadName &thread_name, size_t index) {
+  return thread_name + "#" + std::to_string(index);
+}
+
+/**
+ * @brief Symmetry Groups Class
+ *
+ * Groups of interchangeable threads, e.g. the replicas of a replicated thread
+ * function. Event lists which only differ by a permutation of the threads in
+ * a group describe the same behavior. Such event lists have the same canonical
+ * form, in which the threads of each group are renamed to the group members
+ * in the order of their first appearance.
+ *
+ */
+class SymmetryGroups {
+ public:
+  /**
+   * @brief Add a group of interchangeable threads. A thread should belong to
+   * at most one group.
+   *
+   * @param thread_names Constant reference to the names of the threads in
+   * canonical order
+   */
+  void Add(const std::vector<ThreadName> &thread_names) {
+    std::vector<SymbolId> members;
+    for (const auto &thread_name : thread_names) {
+      SymbolId thread_id = SymbolTable::Instance().Intern(thread_name);
+      membership[thread_id] = {groups.size(), members.size()};
+      members.push_back(thread_id);
+    }
+    groups.push_back(std::move(members));
+  }
+
+  /**
+   * @brief Check if no group has been added.
+   *
+   */
+  bool Empty() const { return groups.empty(); }
+
+  /**
+   * @brief Get the groups as lists of thread identifiers in canonical order.
+   *
+   */
+  const std::vector<std::vector<SymbolId>> &GetGroups() const {
+    return groups;
+  }
+
+  /**
+   * @brief Get the group of a thread.
+   *
+   * @param thread_id Thread identifier
+   * @returns Index of the group or `npos` if the thread is in no group
+   */
+  size_t GetGroup(SymbolId thread_id) const {
+    auto it = membership.find(thread_id);
+    if (it == membership.end()) {
+      return npos;
+    }
+    return it->second.first;
+  }
+
+  /**
+   * @brief Get the canonical form of an event list. Timestamps are retained.
+   *
+   * @param event_list Constant reference to the event list
+   * @returns Canonical event list
+   */
+  EventList Canonicalize(const EventList &event_list) const {
+    Canonicalizer canonicalizer(*this);
+    const std::vector<Timestamp> &timestamps = event_list.GetTimestamps();
+    EventList canonical;
+    canonical.reserve(event_list.size());
+    for (size_t i = 0; i < event_list.size(); ++i) {
+      Event event = canonicalizer.Next(event_list[i]);
+      if (timestamps.empty()) {
+        canonical.push_back(event);
+      } else {
+        canonical.push_back(event, timestamps[i]);
+      }
+    }
+    return canonical;
+  }
+
+  /**
+   * @brief Check if an event list is in canonical form.
+   *
+   * @param event_list Constant reference to the event list
+   * @returns `true` if canonical else `false`
+   */
+  bool IsCanonical(const EventList &event_list) const {
+    Canonicalizer canonicalizer(*this);
+    for (const auto &event : event_list) {
+      if (canonicalizer.Next(event) != event) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Canonicalizer Class
+   *
+   * Incrementally renames the events of a sequence into canonical form.
+   *
+   */
+  class Canonicalizer {
+   public:
+    /**
+     * @brief Construct a new Canonicalizer object
+     *
+     * @param groups Constant reference to the symmetry groups, which should
+     * outlive the canonicalizer
+     */
+    explicit Canonicalizer(const SymmetryGroups &groups)
+        : groups(&groups), assigned(groups.groups.size(), 0) {}
+
+    /**
+     * @brief Restart with an empty sequence of events.
+     *
+     */
+    void Reset() {
+      renaming.clear();
+      std::fill(assigned.begin(), assigned.end(), 0);
+    }
+
+    /**
+     * @brief Get the canonical form of the next event in the sequence.
+     *
+     * @param event Constant reference to the event
+     * @returns Renamed event
+     */
+    Event Next(const Event &event) {
+      SymbolId thread_id = event.GetThreadId();
+      auto it = renaming.find(thread_id);
+      if (it == renaming.end()) {
+        SymbolId canonical = thread_id;
+        auto member = groups->membership.find(thread_id);
+        if (member != groups->membership.end()) {
+          size_t group = member->second.first;
+          canonical = groups->groups[group][assigned[group]++];
+        }
+        it = renaming.emplace(thread_id, canonical).first;
+      }
+      return {it->second, event.GetOperationId(), event.GetEventType()};
+    }
+
+   private:
+    /**
+     * @brief Symmetry groups
+     *
+     */
+    const SymmetryGroups *groups;
+    /**
+     * @brief Number of members assigned in each group
+     *
+     */
+    std::vector<size_t> assigned;
+    /**
+     * @brief Mapping between observed and canonical thread identifiers
+     *
+     */
+    std::unordered_map<SymbolId, SymbolId> renaming;
+  };
+
+  /**
+   * @brief Value returned by `GetGroup` for threads in no group.
+   *
+   */
+  static constexpr size_t npos = SIZE_MAX;
+
+  TSTEST_PRIVATE
+  /**
+   * @brief Thread identifiers of each group in canonical order
+   *
+   */
+  std::vector<std::vector<SymbolId>> groups;
+  /**
+   * @brief Mapping between thread identifier and its group and position
+   *
+   */
+  std::unordered_map<SymbolId, std::pair<size_t, size_t>> membership;
+};
+
+}  // namespace details
+}  // namespace tstest
+
+#endif /* TSTEST__DETAILS__SYMMETRY_HPP */
@@ -0,0 +1,527 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#ifndef TSTEST__DETAILS__TRACE_HPP
+#define TSTEST__DETAILS__TRACE_HPP
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <tstest/details/clock.hpp>
+#include <tstest/details/event.hpp>
+#include <tstest/details/event_log.hpp>
+#include <tstest/details/exception.hpp>
+#include <tstest/details/symbol_table.hpp>
+
+namespace tstest {
+namespace details {
+
+/**
+ * @brief Trace File Header
+ *
+ * A trace file starts with the header followed by fixed-size event records
+ * and ends with the table of interned names used by the records. Each name
+ * table entry is the symbol identifier and name length as two 32-bit integers
+ * followed by the characters of the name. All integers are stored in the
+ * native byte order.
+ *
+ * The event count and name table offset are written when the trace is
+ * closed. If they are zero, e.g. because the writing process crashed, the
+ * event count is inferred from the file size and the names are not available.
+ *
+ */
+struct TraceHeader {
+  /**
+   * @brief File magic `TSTRACE\0`
+   *
+   */
+  char magic[8];
+  /**
+   * @brief Format version
+   *
+   */
+  uint32_t version;
+  /**
+   * @brief Size of an event record in bytes
+   *
+   */
+  uint32_t record_size;
+  /**
+   * @brief Number of event records
+   *
+   */
+  uint64_t event_count;
+  /**
+   * @brief Offset of the name table from the start of the file
+   *
+   */
+  uint64_t names_offset;
+  /**
+   * @brief Number of entries in the name table
+   *
+   */
+  uint64_t names_count;
+};
+
+/**
+ * @brief Trace File Event Record
+ *
+ */
+struct TraceRecord {
+  /**
+   * @brief Timestamp of the event, zero if not timestamped
+   *
+   */
+  Timestamp timestamp;
+  /**
+   * @brief Identifier of the thread name
+   *
+   */
+  SymbolId thread_id;
+  /**
+   * @brief Identifier of the operation name
+   *
+   */
+  SymbolId operation_id;
+  /**
+   * @brief Type of the event
+   *
+   */
+  uint8_t event_type;
+  /**
+   * @brief Padding to keep records 8 byte aligned
+   *
+   */
+  uint8_t reserved[7];
+};
+
+/**
+ * @brief Magic bytes at the start of a trace file.
+ *
+ */
+static const char kTraceMagic[8] = {'T', 'S', 'T', 'R', 'A', 'C', 'E', '\0'};
+
+/**
+ * @brief Version of the trace file format.
+ *
+ */
+static const uint32_t kTraceVersion = 1;
+
+/**
+ * @brief Trace Writer Class
+ *
+ * The writer streams events into a binary trace file. It is used as a
+ * listener of an event log so that events are written while a run is in
+ * progress, or to write complete event lists.
+ *
+ * @note The class is not thread safe. When used as a listener the event log
+ * serializes the calls to `OnEvent`.
+ *
+ */
+class TraceWriter : public EventListener {
+ public:
+  /**
+   * @brief Default size of the write buffer in bytes.
+   *
+   */
+  static constexpr size_t kDefaultBufferSize = 1 << 20;
+
+  /**
+   * @brief Construct a new Trace Writer object and create the trace file. An
+   * exception is thrown if the file cannot be created.
+   *
+   * @param path Constant reference to the path of the trace file
+   * @param buffer_size Size of the write buffer in bytes
+   */
+  explicit TraceWriter(const std::string &path,
+                       size_t buffer_size = kDefaultBufferSize)
+      : path(path), buffer(buffer_size), event_count(0) {
+    file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+      throw TraceError(path, std::strerror(errno));
+    }
+    std::setvbuf(file, buffer.data(), _IOFBF, buffer.size());
+    TraceHeader header = MakeHeader();
+    try {
+      Write(&header, sizeof(header));
+    } catch (const TraceError &) {
+      // The destructor does not run for a failed construction
+      std::fclose(file);
+      throw;
+    }
+  }
+
+  TraceWriter(const TraceWriter &) = delete;
+  TraceWriter &operator=(const TraceWriter &) = delete;
+
+  /**
+   * @brief Destroy the Trace Writer object closing the trace file.
+   *
+   */
+  ~TraceWriter() {
+    try {
+      Close();
+    } catch (const TraceError &) {
+      // Destructors must not throw
+    }
+  }
+
+  /**
+   * @brief Write an event into the trace.
+   *
+   * @param event Constant reference to the event
+   * @param timestamp Timestamp of the event
+   */
+  void Write(const Event &event, Timestamp timestamp = 0) {
+    if (file == nullptr) {
+      throw TraceError(path, "writer is closed");
+    }
+    TraceRecord record = {};
+    record.timestamp = timestamp;
+    record.thread_id = event.GetThreadId();
+    record.operation_id = event.GetOperationId();
+    record.event_type = static_cast<uint8_t>(event.GetEventType());
+    Write(&record, sizeof(record));
+    symbols.insert(record.thread_id);
+    symbols.insert(record.operation_id);
+    ++event_count;
+  }
+
+  /**
+   * @brief Write all events of an event list into the trace.
+   *
+   * @param event_list Constant reference to the event list
+   */
+  void Write(const EventList &event_list) {
+    const std::vector<Timestamp> &timestamps = event_list.GetTimestamps();
+    for (size_t i = 0; i < event_list.size(); ++i) {
+      Write(event_list[i], timestamps.empty() ? 0 : timestamps[i]);
+    }
+  }
+
+  /**
+   * @brief Write an event added to an event log into the trace.
+   *
+   * @param event Constant reference to the added event
+   * @param timestamp Timestamp of the event
+   * @returns Always `true`
+   */
+  bool OnEvent(const Event &event, Timestamp timestamp) override {
+    Write(event, timestamp);
+    return true;
+  }
+
+  /**
+   * @brief Get number of events written.
+   *
+   */
+  uint64_t Size() const { return event_count; }
+
+  /**
+   * @brief Flush the buffered event records into the trace file. The records
+   * written so far can then be read from the incomplete trace, e.g. if the
+   * process is about to crash.
+   *
+   */
+  void Flush() {
+    if (file != nullptr && std::fflush(file) != 0) {
+      throw TraceError(path, std::strerror(errno));
+    }
+  }
+
+  /**
+   * @brief Write the name table, finalize the header and close the trace
+   * file. Closing an already closed writer has no effect.
+   *
+   */
+  void Close() {
+    if (file == nullptr) {
+      return;
+    }
+    TraceHeader header = MakeHeader();
+    header.event_count = event_count;
+    header.names_offset =
+        sizeof(TraceHeader) + event_count * sizeof(TraceRecord);
+    header.names_count = symbols.size();
+    SymbolTable &symbol_table = SymbolTable::Instance();
+    for (auto id : symbols) {
+      const std::string &name = symbol_table.Resolve(id);
+      uint32_t entry[2] = {id, static_cast<uint32_t>(name.size())};
+      Write(entry, sizeof(entry));
+      Write(name.data(), name.size());
+    }
+    bool failed = std::fseek(file, 0, SEEK_SET) != 0;
+    if (!failed) {
+      Write(&header, sizeof(header));
+    }
+    failed = std::fclose(file) != 0 || failed;
+    file = nullptr;
+    if (failed) {
+      throw TraceError(path, "failed to finalize trace");
+    }
+  }
+
+  TSTEST_PRIVATE
+  /**
+   * @brief Create a header with the event count and name table not set.
+   *
+   */
+  static TraceHeader MakeHeader() {
+    TraceHeader header = {};
+    std::memcpy(header.magic, kTraceMagic, sizeof(header.magic));
+    header.version = kTraceVersion;
+    header.record_size = sizeof(TraceRecord);
+    return header;
+  }
+
+  /**
+   * @brief Write bytes into the trace file.
+   *
+   */
+  void Write(const void *data, size_t size) {
+    if (size > 0 && std::fwrite(data, size, 1, file) != 1) {
+      throw TraceError(path, std::strerror(errno));
+    }
+  }
+
+  /**
+   * @brief Path of the trace file
+   *
+   */
+  std::string path;
+  /**
+   * @brief Write buffer
+   *
+   */
+  std::vector<char> buffer;
+  /**
+   * @brief Trace file
+   *
+   */
+  std::FILE *file;
+  /**
+   * @brief Number of events written
+   *
+   */
+  uint64_t event_count;
+  /**
+   * @brief Identifiers of the names used by the written events
+   *
+   */
+  std::unordered_set<SymbolId> symbols;
+};
+
+/**
+ * @brief Trace Reader Class
+ *
+ * The reader maps a trace file into memory. The event records are accessed
+ * in place without parsing, so that opening a trace takes constant time
+ * irrespective of its size. The names in the name table of the trace are
+ * interned in the symbol table when the trace is opened.
+ *
+ */
+class TraceReader {
+ public:
+  /**
+   * @brief Construct a new Trace Reader object mapping the given trace file.
+   * An exception is thrown if the file cannot be mapped or is not a valid
+   * trace.
+   *
+   * @param path Constant reference to the path of the trace file
+   */
+  explicit TraceReader(const std::string &path)
+      : path(path), data(nullptr), size(0), records(nullptr), event_count(0) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw TraceError(path, std::strerror(errno));
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+      ::close(fd);
+      throw TraceError(path, std::strerror(errno));
+    }
+    size = static_cast<size_t>(st.st_size);
+    if (size < sizeof(TraceHeader)) {
+      ::close(fd);
+      throw TraceError(path, "file too small");
+    }
+    void *address = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+      throw TraceError(path, std::strerror(errno));
+    }
+    data = static_cast<const char *>(address);
+    try {
+      Open();
+    } catch (...) {
+      ::munmap(const_cast<char *>(data), size);
+      throw;
+    }
+  }
+
+  TraceReader(const TraceReader &) = delete;
+  TraceReader &operator=(const TraceReader &) = delete;
+
+  /**
+   * @brief Destroy the Trace Reader object unmapping the trace file.
+   *
+   */
+  ~TraceReader() { ::munmap(const_cast<char *>(data), size); }
+
+  /**
+   * @brief Get number of events in the trace.
+   *
+   */
+  size_t Size() const { return event_count; }
+
+  /**
+   * @brief Check if the trace was closed properly by its writer.
+   *
+   */
+  bool IsComplete() const { return GetHeader().names_offset != 0; }
+
+  /**
+   * @brief Get the event at given position.
+   *
+   */
+  Event operator[](size_t index) const {
+    const TraceRecord &record = records[index];
+    return {record.thread_id, record.operation_id,
+            static_cast<Event::Type>(record.event_type)};
+  }
+
+  /**
+   * @brief Get the timestamp of the event at given position.
+   *
+   */
+  Timestamp GetTimestamp(size_t index) const {
+    return records[index].timestamp;
+  }
+
+  /**
+   * @brief Get pointer to the mapped event records.
+   *
+   */
+  const TraceRecord *GetRecords() const { return records; }
+
+  /**
+   * @brief Get the events with positions in the range [first, last) as an
+   * event list, e.g. to run assertions. The range is clamped to the size of
+   * the trace.
+   *
+   * @param first Position of the first event
+   * @param last Position past the last event
+   * @returns List of timestamped events
+   */
+  EventList GetEvents(size_t first = 0, size_t last = SIZE_MAX) const {
+    last = std::min(last, event_count);
+    first = std::min(first, last);
+    EventList event_list;
+    event_list.reserve(last - first);
+    for (size_t i = first; i < last; ++i) {
+      event_list.push_back((*this)[i], records[i].timestamp);
+    }
+    return event_list;
+  }
+
+  TSTEST_PRIVATE
+  /**
+   * @brief Get the mapped header.
+   *
+   */
+  const TraceHeader &GetHeader() const {
+    return *reinterpret_cast<const TraceHeader *>(data);
+  }
+
+  /**
+   * @brief Validate the header, locate the records and intern the names.
+   *
+   */
+  void Open() {
+    const TraceHeader &header = GetHeader();
+    if (std::memcmp(header.magic, kTraceMagic, sizeof(kTraceMagic)) != 0) {
+      throw TraceError(path, "not a trace file");
+    }
+    if (header.version != kTraceVersion ||
+        header.record_size != sizeof(TraceRecord)) {
+      throw TraceError(path, "unsupported trace version");
+    }
+    records = reinterpret_cast<const TraceRecord *>(data + sizeof(TraceHeader));
+    if (header.names_offset == 0) {
+      // Incomplete trace: infer the number of events from the file size
+      event_count = (size - sizeof(TraceHeader)) / sizeof(TraceRecord);
+      return;
+    }
+    event_count = header.event_count;
+    if (header.names_offset > size ||
+        sizeof(TraceHeader) + event_count * sizeof(TraceRecord) >
+            header.names_offset) {
+      throw TraceError(path, "corrupted trace");
+    }
+    // Intern the names so that events of the trace can be resolved
+    size_t offset = header.names_offset;
+    SymbolTable &symbol_table = SymbolTable::Instance();
+    for (uint64_t i = 0; i < header.names_count; ++i) {
+      uint32_t entry[2];
+      if (offset + sizeof(entry) > size) {
+        throw TraceError(path, "corrupted name table");
+      }
+      std::memcpy(entry, data + offset, sizeof(entry));
+      offset += sizeof(entry);
+      if (offset + entry[1] > size) {
+        throw TraceError(path, "corrupted name table");
+      }
+      std::string name(data + offset, entry[1]);
+      offset += entry[1];
+      if (symbol_table.Intern(name) != entry[0]) {
+        throw TraceError(path, "name \"" + name + "\" has invalid identifier");
+      }
+    }
+  }
+
+  /**
+   * @brief Path of the trace file
+   *
+   */
+  std::string path;
+  /**
+   * @brief Start of the mapped file
+   *
+   */
+  const char *data;
+  /**
+   * @brief Size of the mapped file in bytes
+   *
+   */
+  size_t size;
+  /**
+   * @brief Start of the mapped event records
+   *
+   */
+  const TraceRecord *records;
+  /**
+   * @brief Number of event records
+   *
+   */
+  size_t event_count;
+};
+
+}  // namespace details
+}  // namespace tstest
+
+#endif /* TSTEST__DETAILS__TRACE_HPP */
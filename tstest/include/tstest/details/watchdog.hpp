@@ -0,0 +1,318 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#ifndef TSTEST__DETAILS__WATCHDOG_HPP
+#define TSTEST__DETAILS__WATCHDOG_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <tstest/details/defs.hpp>
+#include <tstest/details/event.hpp>
+#include <tstest/details/event_log.hpp>
+
+namespace tstest {
+namespace details {
+
+/**
+ * @brief Get the BEGIN events which are not followed by a matching END event
+ * of the same thread and operation.
+ *
+ * @param event_list Constant reference to the list of events
+ * @returns Open BEGIN events in the order they were logged
+ */
+inline EventList FindOpenOperations(const EventList &event_list) {
+  // Positions of the open BEGIN events of each thread
+  std::unordered_map<SymbolId, std::vector<size_t>> open;
+  for (size_t i = 0; i < event_list.size(); ++i) {
+    Event event = event_list[i];
+    std::vector<size_t> &positions = open[event.GetThreadId()];
+    if (event.GetEventType() == Event::Type::BEGIN) {
+      positions.push_back(i);
+      continue;
+    }
+    // Close the innermost BEGIN of the operation
+    for (auto it = positions.rbegin(); it != positions.rend(); ++it) {
+      if (event_list[*it].GetOperationId() == event.GetOperationId()) {
+        positions.erase(std::next(it).base());
+        break;
+      }
+    }
+  }
+  std::vector<size_t> positions;
+  for (const auto &element : open) {
+    positions.insert(positions.end(), element.second.begin(),
+                     element.second.end());
+  }
+  std::sort(positions.begin(), positions.end());
+  EventList result;
+  for (auto position : positions) {
+    result.push_back(event_list[position]);
+  }
+  return result;
+}
+
+/**
+ * @brief Hang Report
+ *
+ * State of a run which did not finish before its deadline.
+ *
+ */
+struct HangReport {
+  /**
+   * @brief Number of most recent events reported.
+   *
+   */
+  static constexpr size_t kLastEvents = 16;
+
+  /**
+   * @brief Get a human readable description of the hang.
+   *
+   */
+  std::string ToString() const {
+    std::string result =
+        "Run did not finish within " +
+        std::to_string(
+            std::chrono::duration_cast<std::chrono::milliseconds>(deadline)
+                .count()) +
+        " ms\nUnfinished threads:\n";
+    for (const auto &thread_name : unfinished) {
+      result += "  " + thread_name + "\n";
+    }
+    result += "Operations begun but not ended:\n";
+    for (const auto &event : open) {
+      result += "  " + event.ToString() + "\n";
+    }
+    result += "Last events:\n";
+    for (const auto &event : last) {
+      result += "  " + event.ToString() + "\n";
+    }
+    return result;
+  }
+
+  /**
+   * @brief Deadline of the run
+   *
+   */
+  std::chrono::nanoseconds deadline = std::chrono::nanoseconds::zero();
+  /**
+   * @brief Names of the threads which did not return from their function
+   *
+   */
+  std::vector<ThreadName> unfinished;
+  /**
+   * @brief BEGIN events without a matching END event
+   *
+   */
+  EventList open;
+  /**
+   * @brief Most recent events of the run, oldest first
+   *
+   */
+  EventList last;
+};
+
+/**
+ * @brief Watchdog Class
+ *
+ * Monitors the deadline of a run from a thread of its own, which is started on
+ * first use and parked while no run is watched. When the deadline of a run
+ * expires, a report of the run is taken and, depending on the action, the
+ * process is aborted after printing the report, or the event log of the run is
+ * cancelled so that its threads stop at their next event. A cancelled run
+ * which does not finish within a second deadline aborts the process.
+ *
+ */
+class Watchdog {
+ public:
+  /**
+   * @brief Enumerated list of actions taken when a deadline expires.
+   *
+   */
+  enum class Action { ABORT = 0, CANCEL };
+
+  /**
+   * @brief Reporter type called on the monitor thread to describe the run.
+   *
+   */
+  typedef std::function<HangReport()> Reporter;
+
+  /**
+   * @brief Construct a new Watchdog object
+   *
+   */
+  Watchdog() : armed(false), expired(false), stopping(false) {}
+
+  Watchdog(const Watchdog &) = delete;
+  Watchdog &operator=(const Watchdog &) = delete;
+
+  /**
+   * @brief Destroy the Watchdog object stopping the monitor thread.
+   *
+   */
+  ~Watchdog() {
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      stopping = true;
+    }
+    changed.notify_all();
+    if (monitor.joinable()) {
+      monitor.join();
+    }
+  }
+
+  /**
+   * @brief Start watching a run.
+   *
+   * @param deadline Time the run is allowed to take
+   * @param action Action taken when the deadline expires
+   * @param event_log Pointer to the event log of the run
+   * @param reporter Reporter describing the run
+   */
+  void Arm(std::chrono::nanoseconds deadline, Action action,
+           EventLog *event_log, Reporter reporter) {
+    std::lock_guard<std::mutex> guard(lock);
+    this->deadline = deadline;
+    this->action = action;
+    this->event_log = event_log;
+    this->reporter = std::move(reporter);
+    expiry = std::chrono::steady_clock::now() + deadline;
+    armed = true;
+    expired = false;
+    if (!monitor.joinable()) {
+      monitor = std::thread(&Watchdog::Monitor, this);
+    }
+    changed.notify_all();
+  }
+
+  /**
+   * @brief Stop watching the run.
+   *
+   * @returns `true` if the deadline of the run expired else `false`
+   */
+  bool Disarm() {
+    std::lock_guard<std::mutex> guard(lock);
+    armed = false;
+    changed.notify_all();
+    return expired;
+  }
+
+  /**
+   * @brief Get the report of the last run whose deadline expired.
+   *
+   */
+  const HangReport &GetReport() const { return report; }
+
+  TSTEST_PRIVATE
+  /**
+   * @brief Monitor loop waiting for the deadline of the armed run.
+   *
+   */
+  void Monitor() {
+    std::unique_lock<std::mutex> guard(lock);
+    while (!stopping) {
+      if (!armed) {
+        changed.wait(guard);
+        continue;
+      }
+      if (changed.wait_until(guard, expiry) != std::cv_status::timeout ||
+          !armed || std::chrono::steady_clock::now() < expiry) {
+        continue;
+      }
+      if (!expired) {
+        report = reporter();
+        report.deadline = deadline;
+        expired = true;
+        if (action == Action::CANCEL) {
+          event_log->Cancel();
+          expiry += deadline;
+          continue;
+        }
+      }
+      // Aborting or the cancelled run did not finish either
+      std::fprintf(stderr, "%s", report.ToString().c_str());
+      std::fflush(stderr);
+      std::abort();
+    }
+  }
+
+  /**
+   * @brief Lock guarding the watchdog state
+   *
+   */
+  std::mutex lock;
+  /**
+   * @brief Condition signalled when the watchdog is armed, disarmed or stopped
+   *
+   */
+  std::condition_variable changed;
+  /**
+   * @brief Monitor thread, started on first use
+   *
+   */
+  std::thread monitor;
+  /**
+   * @brief Time the watched run is allowed to take
+   *
+   */
+  std::chrono::nanoseconds deadline;
+  /**
+   * @brief Time at which the watchdog fires next
+   *
+   */
+  std::chrono::steady_clock::time_point expiry;
+  /**
+   * @brief Action taken when the deadline expires
+   *
+   */
+  Action action;
+  /**
+   * @brief Event log of the watched run
+   *
+   */
+  EventLog *event_log;
+  /**
+   * @brief Reporter describing the watched run
+   *
+   */
+  Reporter reporter;
+  /**
+   * @brief Report of the last expired run
+   *
+   */
+  HangReport report;
+  /**
+   * @brief Flag indicating that a run is watched
+   *
+   */
+  bool armed;
+  /**
+   * @brief Flag indicating that the deadline of the watched run expired
+   *
+   */
+  bool expired;
+  /**
+   * @brief Flag indicating that the monitor thread should stop
+   *
+   */
+  bool stopping;
+};
+
+}  // namespace details
+}  // namespace tstest
+
+#endif /* TSTEST__DETAILS__WATCHDOG_HPP */
@@ -0,0 +1,182 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#ifndef TSTEST__DETAILS__WORKER_POOL_HPP
+#define TSTEST__DETAILS__WORKER_POOL_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <tstest/details/defs.hpp>
+
+namespace tstest {
+namespace details {
+
+/**
+ * @brief Worker Pool Class
+ *
+ * A pool of persistent worker threads which are parked between rounds. Each
+ * round hands one task to each of the first few workers and releases them
+ * together. The pool grows to the largest number of tasks requested in a
+ * round and its threads are only joined when the pool is destroyed.
+ *
+ * @note The class is not thread safe. Rounds should be run from a single
+ * controlling thread.
+ *
+ */
+class WorkerPool {
+ public:
+  /**
+   * @brief Task type. The task is called with the index of the worker running
+   * it.
+   *
+   */
+  typedef std::function<void(size_t)> Task;
+
+  /**
+   * @brief Construct a new Worker Pool object without any worker.
+   *
+   */
+  WorkerPool()
+      : task(nullptr), generation(0), active(0), pending(0), stopping(false) {}
+
+  WorkerPool(const WorkerPool &) = delete;
+  WorkerPool &operator=(const WorkerPool &) = delete;
+
+  /**
+   * @brief Destroy the Worker Pool object. The parked workers are woken up and
+   * joined.
+   *
+   */
+  ~WorkerPool() {
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      stopping = true;
+    }
+    start.notify_all();
+    for (auto &worker : workers) {
+      worker.join();
+    }
+  }
+
+  /**
+   * @brief Get number of worker threads.
+   *
+   */
+  size_t Size() const { return workers.size(); }
+
+  /**
+   * @brief Run a round of tasks. The workers with index below the given count
+   * are released together and each calls the task with its index. The method
+   * blocks until all the workers have returned from the task.
+   *
+   * @param count Number of workers to run the task on
+   * @param task Constant reference to the task
+   */
+  void Run(size_t count, const Task &task) {
+    // Spawn missing workers parked on the current generation
+    while (workers.size() < count) {
+      workers.emplace_back(&WorkerPool::Work, this, workers.size(),
+                           generation);
+    }
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      this->task = &task;
+      active = count;
+      pending = count;
+      ++generation;
+    }
+    start.notify_all();
+    std::unique_lock<std::mutex> guard(lock);
+    done.wait(guard, [this]() { return pending == 0; });
+    this->task = nullptr;
+  }
+
+  TSTEST_PRIVATE
+  /**
+   * @brief Worker loop parking the worker until the next round.
+   *
+   * @param index Index of the worker
+   * @param seen Generation of the last round seen by the worker
+   */
+  void Work(size_t index, uint64_t seen) {
+    std::unique_lock<std::mutex> guard(lock);
+    while (true) {
+      start.wait(guard,
+                 [this, seen]() { return stopping || generation != seen; });
+      if (stopping) {
+        return;
+      }
+      seen = generation;
+      if (index >= active) {
+        continue;
+      }
+      const Task &round_task = *task;
+      guard.unlock();
+      round_task(index);
+      guard.lock();
+      if (--pending == 0) {
+        done.notify_one();
+      }
+    }
+  }
+
+  /**
+   * @brief Lock guarding the round state
+   *
+   */
+  std::mutex lock;
+  /**
+   * @brief Condition signalled when a round starts or the pool stops
+   *
+   */
+  std::condition_variable start;
+  /**
+   * @brief Condition signalled when all workers of a round have finished
+   *
+   */
+  std::condition_variable done;
+  /**
+   * @brief Worker threads
+   *
+   */
+  std::vector<std::thread> workers;
+  /**
+   * @brief Task of the current round
+   *
+   */
+  const Task *task;
+  /**
+   * @brief Number of the current round
+   *
+   */
+  uint64_t generation;
+  /**
+   * @brief Number of workers running the task in the current round
+   *
+   */
+  size_t active;
+  /**
+   * @brief Number of workers yet to finish the current round
+   *
+   */
+  size_t pending;
+  /**
+   * @brief Flag indicating that the workers should exit
+   *
+   */
+  bool stopping;
+};
+
+}  // namespace details
+}  // namespace tstest
+
+#endif /* TSTEST__DETAILS__WORKER_POOL_HPP */
@@ -9,6 +9,9 @@
 #define TSTEST_HPP
 
 #include <tstest/details/assertor.hpp>
+#include <tstest/details/executor.hpp>
+#include <tstest/details/latency.hpp>
+#include <tstest/details/parallel_enumerator.hpp>
 #include <tstest/details/runner.hpp>
 
 namespace tstest {
@@ -31,6 +34,19 @@ typedef tstest::details::Event Event;
  */
 typedef tstest::details::ExecutionContext ExecutionContext;
 
+/**
+ * @brief The event log contains chronologically ordered sequence of
+ * operational events pushed by one or more threads during testing.
+ *
+ */
+typedef tstest::details::EventLog EventLog;
+
+/**
+ * @brief Configuration used when constructing a `Runner`.
+ *
+ */
+typedef tstest::details::RunnerOptions RunnerOptions;
+
 /**
  * @brief The runner executes set of operations to be tested for thread safety
  * in one or more threads, as configured by the user.
@@ -48,6 +64,88 @@ typedef tstest::details::Runner Runner;
  */
 typedef tstest::details::Assertor Assertor;
 
+/**
+ * @brief Base class of cooperative schedulers deciding which thread logs its
+ * next event when running under `Runner::Run(Scheduler&)`.
+ *
+ */
+typedef tstest::details::Scheduler Scheduler;
+
+/**
+ * @brief Configuration of randomized runs using `Runner::RunPCT`.
+ *
+ */
+typedef tstest::details::PCTOptions PCTOptions;
+
+/**
+ * @brief Stopping criteria used by `Runner::RunUntilCoverage`.
+ *
+ */
+typedef tstest::details::CoverageOptions CoverageOptions;
+
+/**
+ * @brief Statistics of the schedules observed by `Runner::RunUntilCoverage`.
+ *
+ */
+typedef tstest::details::CoverageReport CoverageReport;
+
+/**
+ * @brief Reductions applied when enumerating or running all schedules.
+ *
+ */
+typedef tstest::details::ScheduleOptions ScheduleOptions;
+
+/**
+ * @brief Closed-form count and numbering of the schedules of a list of events.
+ *
+ */
+typedef tstest::details::ScheduleSpace ScheduleSpace;
+
+/**
+ * @brief Configuration used when constructing a `ParallelEnumerator`.
+ *
+ */
+typedef tstest::details::ParallelOptions ParallelOptions;
+
+/**
+ * @brief The parallel enumerator visits all schedules of a list of events on
+ * several worker threads balanced by work stealing.
+ *
+ */
+typedef tstest::details::ParallelEnumerator ParallelEnumerator;
+
+/**
+ * @brief Policy placing the threads of a thread function onto CPUs.
+ *
+ */
+typedef tstest::details::Placement Placement;
+
+/**
+ * @brief Configuration used when constructing a `ScenarioExecutor`.
+ *
+ */
+typedef tstest::details::ExecutorOptions ExecutorOptions;
+
+/**
+ * @brief Results of the scenarios executed by a `ScenarioExecutor`.
+ *
+ */
+typedef tstest::details::ExecutorReport ExecutorReport;
+
+/**
+ * @brief The scenario executor runs many independent runner and assertor pairs
+ * in parallel across the available CPUs.
+ *
+ */
+typedef tstest::details::ScenarioExecutor ScenarioExecutor;
+
+/**
+ * @brief A latency report pairs BEGIN and END events of timestamped event logs
+ * and gives per-operation latency histograms.
+ *
+ */
+typedef tstest::details::LatencyReport LatencyReport;
+
 }  // namespace tstest
 
 /**
@@ -65,9 +163,32 @@ typedef tstest::details::Assertor Assertor;
 #define THREAD(Runner, Name) \
   Runner[Name] = [&](tstest::ExecutionContext context)
 
+/**
+ * @brief Macro used to define a thread function executed by multiple threads.
+ * Each replica gets its index through `context.GetReplicaIndex()`.
+ *
+ * @example
+ *
+ *  Runner runner;
+ *
+ *  THREAD_N(runner, "writer", 64) {
+ *    size_t index = context.GetReplicaIndex();
+ *    ...
+ *  };
+ *
+ */
+#define THREAD_N(Runner, Name, Count) \
+  Runner.Replicate(Name, Count) = [&](tstest::ExecutionContext context)
+
 /**
  * @brief Macro to define an operation.
  *
+ * The operation name must be a string literal. Its symbol identifier is
+ * computed at compile time so that logging the operation events does not
+ * perform any string operations. Operations with names only known at runtime
+ * can be logged using the `LogOperationBegin` and `LogOperationEnd` methods of
+ * the execution context.
+ *
  * @example
  *
  *  Runner runner;
@@ -77,9 +198,9 @@ typedef tstest::details::Assertor Assertor;
  *  };
  *
  */
-#define OPERATION(Name, Expression) \
-  context.LogOperationBegin(Name);  \
-  Expression;                       \
-  context.LogOperationEnd(Name);
+#define OPERATION(Name, Expression)                  \
+  context.LogOperationBegin(TSTEST_SYMBOL_ID(Name)); \
+  Expression;                                        \
+  context.LogOperationEnd(TSTEST_SYMBOL_ID(Name));
 
 #endif /* TSTEST_HPP */
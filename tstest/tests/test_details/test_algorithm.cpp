@@ -12,6 +12,7 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -66,3 +67,54 @@ TEST(TestAlgorithm, TestGetAllSchedules) {
 
   ASSERT_EQ(permutations, expected);
 }
+
+TEST(TestAlgorithm, TestGetAllSchedulesKeepsThreadOrder) {
+  EventList event_list = {
+      {"1", "a", Event::Type::BEGIN}, {"1", "a", Event::Type::END},
+      {"1", "b", Event::Type::BEGIN}, {"1", "b", Event::Type::END},
+      {"2", "a", Event::Type::BEGIN}, {"2", "a", Event::Type::END},
+      {"2", "b", Event::Type::BEGIN}, {"2", "b", Event::Type::END},
+  };
+  std::vector<EventList> permutations;
+
+  GetAllSchedules()(event_list, permutations);
+
+  // 8! / (4! * 4!) interleavings of two threads with four events each
+  ASSERT_EQ(permutations.size(), 70);
+  for (const auto &permutation : permutations) {
+    EventList thread_1;
+    for (const auto &event : permutation) {
+      if (event.GetThreadName() == "1") {
+        thread_1.push_back(event);
+      }
+    }
+    ASSERT_EQ(thread_1, EventList(event_list.begin(), event_list.begin() + 4));
+  }
+}
+
+TEST(TestAlgorithm, TestGetAllSchedulesThreeThreads) {
+  EventList event_list;
+  for (const char *thread : {"1", "2", "3"}) {
+    for (const char *operation : {"a", "b"}) {
+      event_list.push_back({thread, operation, Event::Type::BEGIN});
+      event_list.push_back({thread, operation, Event::Type::END});
+    }
+  }
+  std::vector<EventList> permutations;
+
+  GetAllSchedules()(event_list, permutations);
+
+  // 12! / (4! * 4! * 4!) interleavings out of 479001600 permutations
+  ASSERT_EQ(permutations.size(), 34650);
+  ASSERT_TRUE(std::is_sorted(
+      permutations.begin(), permutations.end(),
+      [](const EventList &a, const EventList &b) {
+        for (size_t i = 0; i < a.size(); ++i) {
+          if (a[i].GetThreadName() != b[i].GetThreadName()) {
+            return a[i].GetThreadName() < b[i].GetThreadName();
+          }
+        }
+        return false;
+      }));
+  ASSERT_EQ(permutations.front(), event_list);
+}
@@ -116,3 +116,50 @@ TEST_F(AssertorTestFixture, TestAssertDefault) {
 
   ASSERT_TRUE(flag);
 }
+
+TEST_F(AssertorTestFixture, TestAssertSealed) {
+  bool flag = false; // Flag indicating if an assertion function was executed
+  EventList event_list = {{thread_name, "test_event-a", Event::Type::BEGIN},
+                          {thread_name, "test_event-a", Event::Type::END}};
+  assertor->Insert(event_list, [&]() { flag = true; });
+
+  event_log->Seal();
+  assertor->Assert(*event_log);
+  ASSERT_TRUE(flag);
+
+  flag = false;
+  assertor->Assert(*event_log, []() { FAIL(); });
+  ASSERT_TRUE(flag);
+}
+
+TEST_F(AssertorTestFixture, TestAssertEventList) {
+  bool flag = false; // Flag indicating if an assertion function was executed
+  EventList event_list = {{thread_name, "test_event-a", Event::Type::BEGIN},
+                          {thread_name, "test_event-a", Event::Type::END}};
+  ASSERT_THROW(assertor->Assert(event_list), NoAssertionFunctionFound);
+
+  assertor->Insert(event_list, [&]() { flag = true; });
+  assertor->Assert(event_list);
+  ASSERT_TRUE(flag);
+}
+
+TEST(AssertorSymmetryTest, TestSetSymmetry) {
+  unsigned int calls = 0;
+  Assertor assertor;
+  assertor.Insert({{"writer#1", "write", Event::Type::BEGIN},
+                   {"writer#0", "write", Event::Type::BEGIN}},
+                  [&]() { ++calls; });
+  SymmetryGroups symmetry;
+  symmetry.Add({"writer#0", "writer#1"});
+  assertor.SetSymmetry(symmetry);
+
+  // Both orders of the interchangeable writers map to the same function
+  assertor.Assert({{"writer#0", "write", Event::Type::BEGIN},
+                   {"writer#1", "write", Event::Type::BEGIN}});
+  assertor.Assert({{"writer#1", "write", Event::Type::BEGIN},
+                   {"writer#0", "write", Event::Type::BEGIN}});
+  ASSERT_EQ(calls, 2);
+  ASSERT_EQ(assertor.GetDispatchTable().size(), 1);
+  ASSERT_THROW(assertor.Get({{"writer#0", "read", Event::Type::BEGIN}}),
+               std::out_of_range);
+}
@@ -0,0 +1,67 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @brief Spin Barrier Class Tests
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Enable debug mode if not already enabled
+ *
+ */
+#ifndef __TSTEST_DEBUG__
+#define __TSTEST_DEBUG__
+#endif
+
+#include <tstest/details/barrier.hpp>
+
+using namespace tstest::details;
+
+TEST(SpinBarrierTest, TestWait) {
+  const unsigned int num_threads = 4;
+  const unsigned int num_rounds = 100;
+  SpinBarrier barrier(num_threads);
+  std::atomic<unsigned int> arrived(0);
+  std::atomic<bool> early(false);
+
+  auto worker = [&]() {
+    for (unsigned int round = 1; round <= num_rounds; ++round) {
+      ++arrived;
+      barrier.Wait();
+      // No thread passes the barrier before all threads arrived
+      if (arrived.load() < round * num_threads) {
+        early = true;
+      }
+      // Keep rounds apart so that arrivals of the next round are not counted
+      barrier.Wait();
+    }
+  };
+  std::vector<std::thread> threads;
+  for (unsigned int i = 0; i < num_threads; ++i) {
+    threads.emplace_back(worker);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_FALSE(early);
+  ASSERT_EQ(arrived.load(), num_threads * num_rounds);
+}
+
+TEST(SpinBarrierTest, TestSingleThread) {
+  SpinBarrier barrier(1);
+  barrier.Wait();
+  barrier.Reset(1);
+  barrier.Wait();
+}
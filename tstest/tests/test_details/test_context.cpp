@@ -54,3 +54,28 @@ TEST_F(ExecutionContextTestFixture, TestLogOperationEnd) {
   ASSERT_TRUE(
       event_log->Contains({thread_name, "test_operation", Event::Type::END}));
 }
+
+TEST_F(ExecutionContextTestFixture, TestLogOperationById) {
+  context->LogOperationBegin(TSTEST_SYMBOL_ID("test_operation"));
+  context->LogOperationEnd(TSTEST_SYMBOL_ID("test_operation"));
+  ASSERT_TRUE(
+      event_log->Contains({thread_name, "test_operation", Event::Type::BEGIN}));
+  ASSERT_TRUE(
+      event_log->Contains({thread_name, "test_operation", Event::Type::END}));
+}
+
+TEST_F(ExecutionContextTestFixture, TestLogOperationBuffered) {
+  EventLog buffered_log(EventLog::Mode::BUFFERED);
+  ExecutionContext buffered_context(&buffered_log,
+                                    buffered_log.CreateBuffer(), thread_name);
+
+  buffered_context.LogOperationBegin("test_operation");
+  buffered_context.LogOperationEnd("test_operation");
+  ASSERT_EQ(buffered_log.Size(), 0);
+
+  buffered_log.Merge();
+  ASSERT_TRUE(buffered_log.Contains(
+      {thread_name, "test_operation", Event::Type::BEGIN}));
+  ASSERT_TRUE(
+      buffered_log.Contains({thread_name, "test_operation", Event::Type::END}));
+}
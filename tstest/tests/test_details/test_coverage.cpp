@@ -0,0 +1,165 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @brief Coverage Tracker Tests
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <vector>
+
+/**
+ * @brief Enable debug mode if not already enabled
+ *
+ */
+#ifndef __TSTEST_DEBUG__
+#define __TSTEST_DEBUG__
+#endif
+
+#include <tstest/details/coverage.hpp>
+#include <tstest/details/runner.hpp>
+
+using namespace tstest::details;
+
+namespace {
+
+EventList Serial() {
+  return {{"thread-a", "operation", Event::Type::BEGIN},
+          {"thread-a", "operation", Event::Type::END},
+          {"thread-b", "operation", Event::Type::BEGIN},
+          {"thread-b", "operation", Event::Type::END}};
+}
+
+EventList Interleaved() {
+  return {{"thread-a", "operation", Event::Type::BEGIN},
+          {"thread-b", "operation", Event::Type::BEGIN},
+          {"thread-a", "operation", Event::Type::END},
+          {"thread-b", "operation", Event::Type::END}};
+}
+
+}  // namespace
+
+TEST(CoverageTrackerTest, TestFrequencies) {
+  CoverageOptions options;
+  options.max_iterations = 3;
+  CoverageTracker tracker(options, nullptr);
+
+  tracker.Add(Serial());
+  ASSERT_FALSE(tracker.Done());
+  tracker.Add(Interleaved());
+  ASSERT_FALSE(tracker.Done());
+  tracker.Add(Serial());
+  ASSERT_TRUE(tracker.Done());
+
+  const CoverageReport &report = tracker.GetReport();
+  // Possible schedules enumerated from the first observed schedule
+  ASSERT_EQ(report.possible, 6);
+  ASSERT_EQ(report.covered, 2);
+  ASSERT_DOUBLE_EQ(report.Coverage(), 2.0 / 6);
+  ASSERT_EQ(report.frequencies.at(Serial()), 2);
+  ASSERT_EQ(report.frequencies.at(Interleaved()), 1);
+  ASSERT_EQ(report.stop_reason, CoverageReport::StopReason::ITERATIONS);
+}
+
+TEST(CoverageTrackerTest, TestTargetCoverage) {
+  CoverageOptions options;
+  options.schedules = {Serial(), Interleaved()};
+  options.target_coverage = 0.5;
+  CoverageTracker tracker(options, nullptr);
+
+  tracker.Add(Serial());
+
+  ASSERT_TRUE(tracker.Done());
+  ASSERT_EQ(tracker.GetReport().possible, 2);
+  ASSERT_EQ(tracker.GetReport().stop_reason,
+            CoverageReport::StopReason::COVERAGE);
+}
+
+TEST(CoverageTrackerTest, TestAssertorCovered) {
+  Assertor assertor;
+  assertor.Insert(Interleaved(), []() {});
+  CoverageOptions options;
+  options.max_iterations = 0;
+  CoverageTracker tracker(options, &assertor);
+
+  tracker.Add(Serial());
+  ASSERT_FALSE(tracker.Done());
+  tracker.Add(Interleaved());
+
+  ASSERT_TRUE(tracker.Done());
+  ASSERT_EQ(tracker.GetReport().asserted, 1);
+  ASSERT_EQ(tracker.GetReport().stop_reason,
+            CoverageReport::StopReason::ASSERTOR_COVERED);
+}
+
+TEST(CoverageTrackerTest, TestAssertorCoveredSymmetric) {
+  Assertor assertor;
+  assertor.Insert(Interleaved(), []() {});
+  SymmetryGroups symmetry;
+  symmetry.Add({"thread-a", "thread-b"});
+  assertor.SetSymmetry(symmetry);
+  CoverageOptions options;
+  options.max_iterations = 0;
+  CoverageTracker tracker(options, &assertor);
+
+  // Interleaved schedule with the threads swapped
+  tracker.Add({{"thread-b", "operation", Event::Type::BEGIN},
+               {"thread-a", "operation", Event::Type::BEGIN},
+               {"thread-b", "operation", Event::Type::END},
+               {"thread-a", "operation", Event::Type::END}});
+  ASSERT_TRUE(tracker.Done());
+  ASSERT_EQ(tracker.GetReport().asserted, 1);
+  ASSERT_EQ(tracker.GetReport().stop_reason,
+            CoverageReport::StopReason::ASSERTOR_COVERED);
+
+  // Symmetric schedules matching the same entry are counted once
+  tracker.Add(Interleaved());
+  ASSERT_EQ(tracker.GetReport().asserted, 1);
+}
+
+TEST(CoverageTrackerTest, TestTimeBudget) {
+  CoverageOptions options;
+  options.max_iterations = 0;
+  options.time_budget = std::chrono::nanoseconds(1);
+  CoverageTracker tracker(options, nullptr);
+
+  tracker.Add(Serial());
+
+  ASSERT_TRUE(tracker.Done());
+  ASSERT_EQ(tracker.GetReport().stop_reason,
+            CoverageReport::StopReason::TIME_BUDGET);
+}
+
+TEST(CoverageTrackerTest, TestRunUntilCoverage) {
+  Runner runner;
+  runner["thread-a"] = [&](ExecutionContext context) {
+    context.LogOperationBegin("operation");
+    context.LogOperationEnd("operation");
+  };
+  runner["thread-b"] = [&](ExecutionContext context) {
+    context.LogOperationBegin("operation");
+    context.LogOperationEnd("operation");
+  };
+  CoverageOptions options;
+  options.max_iterations = 50;
+
+  CoverageReport report = runner.RunUntilCoverage(options);
+
+  ASSERT_GE(report.iterations, 1);
+  ASSERT_LE(report.iterations, 50);
+  ASSERT_EQ(report.possible, 6);
+  ASSERT_GE(report.covered, 1);
+  size_t total = 0;
+  for (const auto &element : report.frequencies) {
+    ASSERT_EQ(element.first.size(), 4);
+    total += element.second;
+  }
+  ASSERT_EQ(total, report.iterations);
+}
@@ -0,0 +1,343 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @brief Schedule Enumerator Tests
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <set>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @brief Enable debug mode if not already enabled
+ *
+ */
+#ifndef __TSTEST_DEBUG__
+#define __TSTEST_DEBUG__
+#endif
+
+#include <tstest/details/algorithm.hpp>
+#include <tstest/details/enumerator.hpp>
+
+using namespace tstest::details;
+
+class ScheduleEnumeratorTestFixture : public ::testing::Test {
+ protected:
+  EventList event_list;
+  void SetUp() override {
+    for (const char *thread : {"1", "2", "3"}) {
+      for (const char *operation : {"a", "b"}) {
+        event_list.push_back({thread, operation, Event::Type::BEGIN});
+        event_list.push_back({thread, operation, Event::Type::END});
+      }
+    }
+  }
+  void TearDown() override {}
+};
+
+TEST_F(ScheduleEnumeratorTestFixture, TestNext) {
+  std::vector<EventList> expected;
+  GetAllSchedules()(event_list, expected);
+
+  ScheduleEnumerator enumerator(event_list);
+  const EventList *buffer = &enumerator.Get();
+  size_t count = 0;
+  while (enumerator.Next()) {
+    ASSERT_EQ(enumerator.Get(), expected[count]);
+    ASSERT_EQ(&enumerator.Get(), buffer);
+    ++count;
+  }
+  ASSERT_EQ(count, 34650);
+  ASSERT_FALSE(enumerator.Next());
+  ASSERT_EQ(enumerator.GetThreadCount(), 3);
+
+  enumerator.Reset();
+  ASSERT_TRUE(enumerator.Next());
+  ASSERT_EQ(enumerator.Get(), event_list);
+  ASSERT_EQ(enumerator.GetThreads(),
+            std::vector<size_t>({0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2}));
+}
+
+TEST_F(ScheduleEnumeratorTestFixture, TestIterator) {
+  EventList small = {{"1", "a", Event::Type::BEGIN},
+                     {"1", "a", Event::Type::END},
+                     {"2", "a", Event::Type::BEGIN}};
+  ScheduleEnumerator enumerator(small);
+  std::vector<EventList> schedules;
+  for (const auto &schedule : enumerator) {
+    schedules.push_back(schedule);
+  }
+  std::vector<EventList> expected;
+  GetAllSchedules()(small, expected);
+  ASSERT_EQ(schedules, expected);
+  ASSERT_EQ(schedules.size(), 3);
+
+  // Empty list has the empty schedule only
+  ScheduleEnumerator empty((EventList()));
+  ASSERT_TRUE(empty.Next());
+  ASSERT_TRUE(empty.Get().empty());
+  ASSERT_FALSE(empty.Next());
+}
+
+/**
+ * @brief Get the lexicographically smallest schedule of the Mazurkiewicz
+ * trace of a schedule, with threads ordered by name.
+ *
+ */
+static EventList GetNormalForm(EventList schedule,
+                               const Independence &independence) {
+  EventList normal;
+  while (!schedule.empty()) {
+    size_t best = schedule.size();
+    std::set<ThreadName> seen;
+    for (size_t i = 0; i < schedule.size(); ++i) {
+      ThreadName thread = schedule[i].GetThreadName();
+      if (!seen.insert(thread).second) {
+        continue;
+      }
+      bool movable = true;
+      for (size_t j = 0; j < i && movable; ++j) {
+        movable = independence.IsIndependent(schedule[j], schedule[i]);
+      }
+      if (movable &&
+          (best == schedule.size() ||
+           thread < schedule[best].GetThreadName())) {
+        best = i;
+      }
+    }
+    normal.push_back(schedule[best]);
+    EventList rest;
+    for (size_t i = 0; i < schedule.size(); ++i) {
+      if (i != best) {
+        rest.push_back(schedule[i]);
+      }
+    }
+    schedule = rest;
+  }
+  return normal;
+}
+
+TEST(ScheduleEnumeratorTest, TestPartialOrderReduction) {
+  EventList event_list;
+  std::vector<std::vector<const char *>> operations = {
+      {"key-a", "key-b"}, {"key-b", "key-a"}, {"key-a"}};
+  for (size_t i = 0; i < operations.size(); ++i) {
+    std::string thread = std::to_string(i + 1);
+    for (const char *operation : operations[i]) {
+      event_list.push_back({thread, operation, Event::Type::BEGIN});
+      event_list.push_back({thread, operation, Event::Type::END});
+    }
+  }
+  ScheduleOptions options;
+  options.independence.Add("key-a", "key-b");
+
+  // Traces of all the schedules
+  std::unordered_set<EventList, EventListHash> traces;
+  ScheduleEnumerator all(event_list);
+  while (all.Next()) {
+    traces.insert(GetNormalForm(all.Get(), options.independence));
+  }
+  ASSERT_EQ(all.GetReport().explored, 3150);
+
+  // One schedule per trace
+  ScheduleEnumerator reduced(event_list, options);
+  std::unordered_set<EventList, EventListHash> representatives;
+  while (reduced.Next()) {
+    ASSERT_EQ(GetNormalForm(reduced.Get(), options.independence),
+              reduced.Get());
+    ASSERT_TRUE(representatives.insert(reduced.Get()).second);
+  }
+  ASSERT_EQ(representatives, traces);
+  ASSERT_EQ(reduced.GetReport().total, 3150);
+  ASSERT_EQ(reduced.GetReport().explored, traces.size());
+  ASSERT_LT(reduced.GetReport().explored, 3150);
+  ASSERT_GT(reduced.GetReport().Reduction(), 1);
+}
+
+TEST(ScheduleEnumeratorTest, TestSymmetryReduction) {
+  // Readers logged out of canonical order
+  EventList event_list;
+  for (const char *thread : {"reader#2", "writer", "reader#0", "reader#1"}) {
+    const char *operation = thread[0] == 'r' ? "read" : "write";
+    event_list.push_back({thread, operation, Event::Type::BEGIN});
+    event_list.push_back({thread, operation, Event::Type::END});
+  }
+  ScheduleOptions options;
+  options.symmetry.Add({"reader#0", "reader#1", "reader#2"});
+
+  // Canonical schedules, pruned rather than filtered
+  std::vector<EventList> filtered;
+  ScheduleEnumerator all(event_list);
+  while (all.Next()) {
+    if (options.symmetry.IsCanonical(all.Get())) {
+      filtered.push_back(all.Get());
+    }
+  }
+  std::vector<EventList> canonical;
+  ScheduleEnumerator pruned(event_list, options);
+  while (pruned.Next()) {
+    canonical.push_back(pruned.Get());
+  }
+  // Every schedule has one permutation per ordering of the readers
+  ASSERT_EQ(pruned.GetReport().total, 2520);
+  ASSERT_EQ(canonical.size(), 2520 / 6);
+  ASSERT_TRUE(canonical == filtered);
+
+  // One canonical schedule of each trace holding a canonical schedule
+  options.independence.Add("read", "read");
+  std::unordered_set<EventList, EventListHash> traces;
+  for (const auto &schedule : filtered) {
+    traces.insert(GetNormalForm(schedule, options.independence));
+  }
+  ScheduleEnumerator reduced(event_list, options);
+  std::unordered_set<EventList, EventListHash> representatives;
+  while (reduced.Next()) {
+    ASSERT_TRUE(options.symmetry.IsCanonical(reduced.Get()));
+    ASSERT_TRUE(representatives
+                    .insert(GetNormalForm(reduced.Get(), options.independence))
+                    .second);
+  }
+  ASSERT_TRUE(representatives == traces);
+  ASSERT_LT(representatives.size(), canonical.size());
+
+  // Without the second member, the third member never starts canonically
+  EventList incomplete;
+  for (const char *thread : {"reader#0", "reader#2"}) {
+    incomplete.push_back({thread, "read", Event::Type::BEGIN});
+    incomplete.push_back({thread, "read", Event::Type::END});
+  }
+  ScheduleEnumerator empty(incomplete, options);
+  ASSERT_FALSE(empty.Next());
+}
+
+/**
+ * @brief Check if no thread begins an operation of the group while another
+ * thread is inside one.
+ *
+ */
+static bool IsExclusive(const EventList &schedule,
+                        const std::set<OperationName> &group) {
+  std::string holder;
+  int depth = 0;
+  for (const auto &event : schedule) {
+    if (group.count(event.GetOperationName()) == 0) {
+      continue;
+    }
+    if (event.GetEventType() == Event::Type::BEGIN) {
+      if (depth > 0 && holder != event.GetThreadName()) {
+        return false;
+      }
+      holder = event.GetThreadName();
+      ++depth;
+    } else {
+      --depth;
+    }
+  }
+  return true;
+}
+
+TEST(ScheduleEnumeratorTest, TestHappensBefore) {
+  EventList event_list = {{"producer", "push", Event::Type::BEGIN},
+                          {"producer", "push", Event::Type::END},
+                          {"producer", "push", Event::Type::BEGIN},
+                          {"producer", "push", Event::Type::END},
+                          {"consumer", "pop", Event::Type::BEGIN},
+                          {"consumer", "pop", Event::Type::END},
+                          {"consumer", "pop", Event::Type::BEGIN},
+                          {"consumer", "pop", Event::Type::END}};
+  ScheduleOptions options;
+  options.constraints.AddHappensBefore(
+      {"producer", "push", Event::Type::BEGIN},
+      {"consumer", "pop", Event::Type::END});
+
+  // The k-th pop ends after the k-th push began
+  std::vector<EventList> feasible;
+  ScheduleEnumerator all(event_list);
+  while (all.Next()) {
+    size_t pushes = 0;
+    size_t pops = 0;
+    bool ordered = true;
+    for (const auto &event : all.Get()) {
+      if (event.GetOperationName() == "push" &&
+          event.GetEventType() == Event::Type::BEGIN) {
+        ++pushes;
+      } else if (event.GetOperationName() == "pop" &&
+                 event.GetEventType() == Event::Type::END) {
+        ordered = ordered && ++pops <= pushes;
+      }
+    }
+    if (ordered) {
+      feasible.push_back(all.Get());
+    }
+  }
+
+  std::vector<EventList> constrained;
+  ScheduleEnumerator enumerator(event_list, options);
+  while (enumerator.Next()) {
+    constrained.push_back(enumerator.Get());
+  }
+  ASSERT_TRUE(constrained == feasible);
+  ASSERT_EQ(enumerator.GetReport().total, 70);
+  ASSERT_LT(constrained.size(), 70);
+}
+
+TEST(ScheduleEnumeratorTest, TestMutualExclusion) {
+  EventList event_list;
+  for (const char *thread : {"1", "2"}) {
+    for (const char *operation : {"lock-a", "lock-b", "log"}) {
+      event_list.push_back({thread, operation, Event::Type::BEGIN});
+      event_list.push_back({thread, operation, Event::Type::END});
+    }
+  }
+  event_list.push_back({"3", "log", Event::Type::BEGIN});
+  event_list.push_back({"3", "log", Event::Type::END});
+  std::set<OperationName> group = {"lock-a", "lock-b"};
+  ScheduleOptions options;
+  options.constraints.AddMutualExclusion({"lock-a", "lock-b"});
+
+  // Feasible schedules and their traces
+  options.independence.Add("log", "log");
+  options.independence.Add("log", "lock-a");
+  options.independence.Add("log", "lock-b");
+  std::vector<EventList> feasible;
+  std::unordered_set<EventList, EventListHash> traces;
+  ScheduleEnumerator all(event_list);
+  while (all.Next()) {
+    if (IsExclusive(all.Get(), group)) {
+      feasible.push_back(all.Get());
+      traces.insert(GetNormalForm(all.Get(), options.independence));
+    }
+  }
+
+  // Without partial-order reduction, exactly the feasible schedules
+  ScheduleOptions exclusive;
+  exclusive.constraints = options.constraints;
+  std::vector<EventList> constrained;
+  ScheduleEnumerator enumerator(event_list, exclusive);
+  while (enumerator.Next()) {
+    constrained.push_back(enumerator.Get());
+  }
+  ASSERT_TRUE(constrained == feasible);
+  ASSERT_LT(constrained.size(), enumerator.GetReport().total);
+
+  // With partial-order reduction, one feasible schedule per trace
+  ScheduleEnumerator reduced(event_list, options);
+  std::unordered_set<EventList, EventListHash> representatives;
+  while (reduced.Next()) {
+    ASSERT_TRUE(IsExclusive(reduced.Get(), group));
+    ASSERT_TRUE(representatives
+                    .insert(GetNormalForm(reduced.Get(), options.independence))
+                    .second);
+  }
+  ASSERT_TRUE(representatives == traces);
+  ASSERT_LT(representatives.size(), feasible.size());
+}
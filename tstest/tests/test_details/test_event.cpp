@@ -12,9 +12,13 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <thread>
+#include <type_traits>
+#include <vector>
 
 /**
  * @brief Enable debug mode if not already enabled
@@ -56,6 +60,20 @@ TEST_F(EventTestFixture, TestGetThreadName) {
   ASSERT_EQ(end_event->GetThreadName(), thread_name);
 }
 
+TEST_F(EventTestFixture, TestGetIds) {
+  SymbolTable &symbols = SymbolTable::Instance();
+  ASSERT_EQ(begin_event->GetThreadId(), symbols.Intern(thread_name));
+  ASSERT_EQ(begin_event->GetOperationId(), symbols.Intern("test-event"));
+  ASSERT_EQ(*begin_event, Event(symbols.Intern(thread_name),
+                                symbols.Intern("test-event"),
+                                Event::Type::BEGIN));
+}
+
+TEST_F(EventTestFixture, TestTriviallyCopyable) {
+  ASSERT_TRUE(std::is_trivially_copyable<Event>::value);
+  ASSERT_LE(sizeof(Event), 12);
+}
+
 TEST_F(EventTestFixture, TestToString) {
   ASSERT_EQ(begin_event->ToString(), "{\"test\", \"test-event\", tstest::Event::Type::BEGIN}");
   ASSERT_EQ(end_event->ToString(), "{\"test\", \"test-event\", tstest::Event::Type::END}");
@@ -85,9 +103,9 @@ TEST(EventHashTestFixture, TestHashValue) {
   Event end_event("test", "test-event", Event::Type::END);
 
   size_t begin_event_hash = event_hash(begin_event);
-  size_t begin_event_hash_expected = 20698882074881470U;
+  size_t begin_event_hash_expected = 3676378996039U;
   size_t end_event_hash = event_hash(end_event);
-  size_t end_event_hash_expected = 14982950806565649480U;
+  size_t end_event_hash_expected = 3676378996100U;
 
   ASSERT_EQ(begin_event_hash, begin_event_hash_expected);
   ASSERT_EQ(end_event_hash, end_event_hash_expected);
@@ -104,7 +122,114 @@ TEST(EventListHashTestFixture, TestHashValue) {
                           {"test", "test-event", Event::Type::END}};
 
   size_t hash = event_list_hash(event_list);
-  size_t hash_expected = 16297242731351833291U;
+  size_t hash_expected = 2932669899789783223U;
 
   ASSERT_EQ(hash, hash_expected);
 }
+
+TEST(EventListHashTestFixture, TestHashOrder) {
+  EventListHash event_list_hash;
+  EventList event_list = {{"test", "test-event-a", Event::Type::BEGIN},
+                          {"test", "test-event-b", Event::Type::BEGIN}};
+  EventList reversed_list = {{"test", "test-event-b", Event::Type::BEGIN},
+                             {"test", "test-event-a", Event::Type::BEGIN}};
+
+  ASSERT_NE(event_list_hash(event_list), event_list_hash(reversed_list));
+}
+
+/**
+ * @brief EventList Class Tests
+ *
+ */
+
+TEST(EventListTestFixture, TestPushBack) {
+  EventList event_list;
+  event_list.reserve(8);
+  event_list.push_back({"test", "test-event-a", Event::Type::BEGIN});
+  event_list.push_back({"test", "test-event-a", Event::Type::END});
+
+  ASSERT_GE(event_list.capacity(), 8);
+  ASSERT_EQ(event_list.size(), 2);
+  ASSERT_EQ(event_list.front(),
+            Event("test", "test-event-a", Event::Type::BEGIN));
+  ASSERT_EQ(event_list.back(), Event("test", "test-event-a", Event::Type::END));
+
+  event_list.pop_back();
+  ASSERT_EQ(event_list.size(), 1);
+  event_list.clear();
+  ASSERT_TRUE(event_list.empty());
+  ASSERT_GE(event_list.capacity(), 8);
+}
+
+TEST(EventListTestFixture, TestIteration) {
+  std::vector<Event> events = {{"test-a", "test-event-a", Event::Type::BEGIN},
+                               {"test-b", "test-event-b", Event::Type::BEGIN},
+                               {"test-a", "test-event-a", Event::Type::END}};
+  EventList event_list(events.begin(), events.end());
+
+  size_t index = 0;
+  for (const auto &event : event_list) {
+    ASSERT_EQ(event, events[index]);
+    ASSERT_EQ(event_list[index], events[index]);
+    ++index;
+  }
+  ASSERT_EQ(index, events.size());
+  ASSERT_EQ(event_list.end() - event_list.begin(), 3);
+  ASSERT_EQ(event_list.begin()->GetThreadName(), "test-a");
+
+  // Events are yielded by value, so the iterator is an input iterator
+  typedef std::iterator_traits<EventList::const_iterator> traits;
+  ASSERT_TRUE((std::is_same<traits::iterator_category,
+                            std::input_iterator_tag>::value));
+  auto it = std::find(event_list.begin(), event_list.end(), events[1]);
+  ASSERT_EQ(it - event_list.begin(), 1);
+  ASSERT_TRUE(std::equal(event_list.begin(), event_list.end(), events.begin()));
+
+  // Forwarding references bind to the yielded events as well
+  index = 0;
+  for (auto &&event : event_list) {
+    ASSERT_EQ(event, events[index++]);
+  }
+  ASSERT_EQ(index, events.size());
+}
+
+TEST(EventListTestFixture, TestColumns) {
+  EventList event_list = {{"test-a", "test-event-a", Event::Type::BEGIN},
+                          {"test-b", "test-event-b", Event::Type::END}};
+
+  ASSERT_EQ(event_list.GetThreadIds(),
+            std::vector<SymbolId>({HashSymbol("test-a"), HashSymbol("test-b")}));
+  ASSERT_EQ(event_list.GetOperationIds(),
+            std::vector<SymbolId>(
+                {HashSymbol("test-event-a"), HashSymbol("test-event-b")}));
+  ASSERT_EQ(event_list.GetEventTypes(),
+            std::vector<Event::Type>({Event::Type::BEGIN, Event::Type::END}));
+}
+
+TEST(EventListTestFixture, TestEquality) {
+  EventList event_list = {{"test", "test-event", Event::Type::BEGIN},
+                          {"test", "test-event", Event::Type::END}};
+  EventList same_list = {{"test", "test-event", Event::Type::BEGIN},
+                         {"test", "test-event", Event::Type::END}};
+  EventList other_list = {{"test", "test-event", Event::Type::BEGIN},
+                          {"test", "test-event", Event::Type::BEGIN}};
+
+  ASSERT_TRUE(event_list == same_list);
+  ASSERT_TRUE(event_list != other_list);
+}
+
+TEST(EventListTestFixture, TestTimestamps) {
+  EventList event_list;
+  event_list.push_back({"test", "test-event", Event::Type::BEGIN});
+  ASSERT_FALSE(event_list.HasTimestamps());
+
+  // Earlier events get a zero timestamp
+  event_list.push_back({"test", "test-event", Event::Type::END}, 42);
+  ASSERT_TRUE(event_list.HasTimestamps());
+  ASSERT_EQ(event_list.GetTimestamps(), std::vector<Timestamp>({0, 42}));
+
+  // Timestamps are ignored by comparison
+  EventList other_list = {{"test", "test-event", Event::Type::BEGIN},
+                          {"test", "test-event", Event::Type::END}};
+  ASSERT_TRUE(event_list == other_list);
+}
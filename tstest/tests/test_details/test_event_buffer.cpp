@@ -0,0 +1,92 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @brief EventBuffer Class Tests
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+
+/**
+ * @brief Enable debug mode if not already enabled
+ *
+ */
+#ifndef __TSTEST_DEBUG__
+#define __TSTEST_DEBUG__
+#endif
+
+#include <tstest/details/event_buffer.hpp>
+
+using namespace tstest::details;
+
+class EventBufferTestFixture : public ::testing::Test {
+ protected:
+  std::unique_ptr<EventBuffer> event_buffer;
+  void SetUp() override { event_buffer = std::make_unique<EventBuffer>(4); }
+  void TearDown() override {}
+};
+
+TEST_F(EventBufferTestFixture, TestCapacity) {
+  ASSERT_EQ(event_buffer->Size(), 0);
+  ASSERT_GE(event_buffer->Capacity(), 4);
+}
+
+TEST_F(EventBufferTestFixture, TestPush) {
+  event_buffer->Push(3, {"thread-a", "test_event-a", Event::Type::BEGIN});
+  event_buffer->Push(7, {"thread-a", "test_event-a", Event::Type::END});
+
+  ASSERT_EQ(event_buffer->Size(), 2);
+  const auto &records = event_buffer->GetRecords();
+  ASSERT_EQ(records[0].sequence, 3);
+  ASSERT_EQ(records[0].event,
+            Event("thread-a", "test_event-a", Event::Type::BEGIN));
+  ASSERT_EQ(records[1].sequence, 7);
+  ASSERT_EQ(records[1].event,
+            Event("thread-a", "test_event-a", Event::Type::END));
+}
+
+TEST_F(EventBufferTestFixture, TestSnapshot) {
+  std::atomic<bool> done(false);
+  std::thread producer([&]() {
+    for (unsigned int i = 0; i < 1024; ++i) {
+      event_buffer->Push(i, {"thread-a", "test_event-a", Event::Type::BEGIN});
+    }
+    done = true;
+  });
+  // Snapshots taken while the buffer grows hold a prefix of the records
+  size_t size = 0;
+  while (!done) {
+    auto records = event_buffer->Snapshot();
+    ASSERT_GE(records.size(), size);
+    for (size_t i = 0; i < records.size(); ++i) {
+      ASSERT_EQ(records[i].sequence, i);
+    }
+    size = records.size();
+  }
+  producer.join();
+  ASSERT_EQ(event_buffer->Snapshot().size(), 1024);
+
+  event_buffer->Clear();
+  ASSERT_TRUE(event_buffer->Snapshot().empty());
+}
+
+TEST_F(EventBufferTestFixture, TestClear) {
+  for (unsigned int i = 0; i < 8; ++i) {
+    event_buffer->Push(i, {"thread-a", "test_event-a", Event::Type::BEGIN});
+  }
+  size_t capacity = event_buffer->Capacity();
+  event_buffer->Clear();
+
+  ASSERT_EQ(event_buffer->Size(), 0);
+  ASSERT_EQ(event_buffer->Capacity(), capacity);
+}
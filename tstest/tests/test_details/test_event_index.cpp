@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @brief EventIndex Class Tests
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+/**
+ * @brief Enable debug mode if not already enabled
+ *
+ */
+#ifndef __TSTEST_DEBUG__
+#define __TSTEST_DEBUG__
+#endif
+
+#include <tstest/details/event_index.hpp>
+
+using namespace tstest::details;
+
+class EventIndexTestFixture : public ::testing::Test {
+ protected:
+  EventList events = {{"thread-a", "test_event-a", Event::Type::BEGIN},
+                      {"thread-b", "test_event-b", Event::Type::BEGIN},
+                      {"thread-a", "test_event-a", Event::Type::END},
+                      {"thread-a", "test_event-a", Event::Type::BEGIN},
+                      {"thread-b", "test_event-b", Event::Type::END},
+                      {"thread-a", "test_event-a", Event::Type::END}};
+  std::unique_ptr<EventIndex> index;
+  void SetUp() override { index = std::make_unique<EventIndex>(events); }
+  void TearDown() override {}
+};
+
+TEST_F(EventIndexTestFixture, TestContains) {
+  ASSERT_TRUE(index->Contains({"thread-a", "test_event-a", Event::Type::END}));
+  ASSERT_FALSE(
+      index->Contains({"thread-a", "test_event-b", Event::Type::BEGIN}));
+}
+
+TEST_F(EventIndexTestFixture, TestCount) {
+  ASSERT_EQ(index->Count({"thread-a", "test_event-a", Event::Type::BEGIN}), 2);
+  ASSERT_EQ(index->Count({"thread-b", "test_event-b", Event::Type::BEGIN}), 1);
+  ASSERT_EQ(index->Count({"thread-b", "test_event-a", Event::Type::BEGIN}), 0);
+}
+
+TEST_F(EventIndexTestFixture, TestFind) {
+  Event event("thread-a", "test_event-a", Event::Type::BEGIN);
+
+  ASSERT_EQ(index->Find(event), 0);
+  ASSERT_EQ(index->Find(event, 1), 3);
+  ASSERT_EQ(index->Find(event, 2), static_cast<size_t>(EventIndex::npos));
+}
+
+TEST_F(EventIndexTestFixture, TestGetThreadEvents) {
+  ASSERT_EQ(index->GetThreadEvents(HashSymbol("thread-a")),
+            EventIndex::PositionList({0, 2, 3, 5}));
+  ASSERT_EQ(index->GetThreadEvents(HashSymbol("thread-b")),
+            EventIndex::PositionList({1, 4}));
+  ASSERT_TRUE(index->GetThreadEvents(HashSymbol("thread-c")).empty());
+}
+
+TEST_F(EventIndexTestFixture, TestBetween) {
+  EventRange range = index->Between(1, 3);
+  ASSERT_EQ(range.size(), 2);
+  ASSERT_EQ(*range.begin(),
+            Event("thread-b", "test_event-b", Event::Type::BEGIN));
+  ASSERT_EQ(*(range.begin() + 1),
+            Event("thread-a", "test_event-a", Event::Type::END));
+
+  // Range is clamped to the indexed events
+  ASSERT_EQ(index->Between(4, 100).size(), 2);
+  ASSERT_TRUE(index->Between(10, 100).empty());
+}
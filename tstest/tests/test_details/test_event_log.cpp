@@ -85,3 +85,129 @@ TEST_F(EventLogTestFixture, TestEqualityOperator) {
 
   ASSERT_TRUE(*event_log == events);
 }
+
+TEST(BufferedEventLogTest, TestMerge) {
+  EventLog event_log(EventLog::Mode::BUFFERED, 16);
+  EventBuffer *buffer_a = event_log.CreateBuffer();
+  EventBuffer *buffer_b = event_log.CreateBuffer();
+
+  buffer_a->Push(event_log.Stamp(),
+                 {"thread-a", "test_event-a", Event::Type::BEGIN});
+  buffer_b->Push(event_log.Stamp(),
+                 {"thread-b", "test_event-b", Event::Type::BEGIN});
+  buffer_b->Push(event_log.Stamp(),
+                 {"thread-b", "test_event-b", Event::Type::END});
+  buffer_a->Push(event_log.Stamp(),
+                 {"thread-a", "test_event-a", Event::Type::END});
+
+  // Events are only visible after the buffers are merged
+  ASSERT_EQ(event_log.Size(), 0);
+  event_log.Merge();
+
+  std::list<Event> events = {
+      {"thread-a", "test_event-a", Event::Type::BEGIN},
+      {"thread-b", "test_event-b", Event::Type::BEGIN},
+      {"thread-b", "test_event-b", Event::Type::END},
+      {"thread-a", "test_event-a", Event::Type::END}};
+
+  ASSERT_TRUE(event_log == events);
+}
+
+TEST(BufferedEventLogTest, TestReuseBuffers) {
+  EventLog event_log(EventLog::Mode::BUFFERED, 16);
+  EventBuffer *buffer = event_log.CreateBuffer();
+  buffer->Push(event_log.Stamp(),
+               {"thread-a", "test_event-a", Event::Type::BEGIN});
+  event_log.Merge();
+
+  // Merged buffers are handed out again empty with their capacity retained
+  EventBuffer *reused = event_log.CreateBuffer();
+  ASSERT_EQ(reused, buffer);
+  ASSERT_EQ(reused->Size(), 0);
+  ASSERT_GE(reused->Capacity(), 16);
+  ASSERT_NE(event_log.CreateBuffer(), buffer);
+
+  event_log.Clear();
+  ASSERT_EQ(event_log.CreateBuffer(), buffer);
+}
+
+TEST(BufferedEventLogTest, TestConcurrentPush) {
+  const unsigned int num_events = 1000;
+  EventLog event_log(EventLog::Mode::BUFFERED, num_events);
+
+  auto producer = [&](EventBuffer *buffer, const std::string &thread_name) {
+    for (unsigned int i = 0; i < num_events; ++i) {
+      buffer->Push(event_log.Stamp(),
+                   {thread_name, std::to_string(i), Event::Type::BEGIN});
+    }
+  };
+  std::thread thread_a(producer, event_log.CreateBuffer(), "thread-a");
+  std::thread thread_b(producer, event_log.CreateBuffer(), "thread-b");
+  thread_a.join();
+  thread_b.join();
+  event_log.Merge();
+
+  ASSERT_EQ(event_log.Size(), 2 * num_events);
+  // Per-thread program order is preserved by the merge
+  unsigned int next_a = 0, next_b = 0;
+  for (const auto &event : event_log.GetEvents()) {
+    unsigned int &next = event.GetThreadName() == "thread-a" ? next_a : next_b;
+    ASSERT_EQ(event.GetOperationName(), std::to_string(next));
+    ++next;
+  }
+}
+
+TEST_F(EventLogTestFixture, TestSeal) {
+  event_log->Push({"thread-a", "test_event-first", Event::Type::BEGIN});
+  ASSERT_FALSE(event_log->IsSealed());
+  ASSERT_THROW(event_log->View(), EventLogNotSealed);
+
+  event_log->Seal();
+  ASSERT_TRUE(event_log->IsSealed());
+  ASSERT_THROW(
+      event_log->Push({"thread-a", "test_event-last", Event::Type::BEGIN}),
+      EventLogSealed);
+
+  const EventList &view = event_log->View();
+  ASSERT_EQ(view.size(), 1);
+  ASSERT_EQ(&view, &event_log->View());
+  ASSERT_EQ(view.front(),
+            Event("thread-a", "test_event-first", Event::Type::BEGIN));
+
+  event_log->Unseal();
+  event_log->Push({"thread-a", "test_event-last", Event::Type::BEGIN});
+  ASSERT_EQ(event_log->Size(), 2);
+}
+
+TEST_F(EventLogTestFixture, TestIndexedQueries) {
+  event_log->Push({"thread-a", "test_event-a", Event::Type::BEGIN});
+  event_log->Push({"thread-b", "test_event-b", Event::Type::BEGIN});
+  event_log->Push({"thread-a", "test_event-a", Event::Type::END});
+  ASSERT_THROW(
+      event_log->Count({"thread-a", "test_event-a", Event::Type::BEGIN}),
+      EventLogNotSealed);
+
+  event_log->Seal();
+  ASSERT_TRUE(
+      event_log->Contains({"thread-b", "test_event-b", Event::Type::BEGIN}));
+  ASSERT_FALSE(
+      event_log->Contains({"thread-b", "test_event-b", Event::Type::END}));
+  ASSERT_EQ(event_log->Count({"thread-a", "test_event-a", Event::Type::END}),
+            1);
+  ASSERT_EQ(event_log->Find({"thread-a", "test_event-a", Event::Type::END}),
+            2);
+  ASSERT_EQ(event_log->GetThreadEvents("thread-a"),
+            std::vector<size_t>({0, 2}));
+  // Unknown threads are looked up without being interned
+  size_t symbols = SymbolTable::Instance().Size();
+  ASSERT_TRUE(event_log->GetThreadEvents("thread-unknown").empty());
+  ASSERT_EQ(SymbolTable::Instance().Size(), symbols);
+  ASSERT_EQ(event_log->Between(1, 3).size(), 2);
+
+  // Index is rebuilt after the log is modified
+  event_log->Unseal();
+  event_log->Push({"thread-b", "test_event-b", Event::Type::END});
+  event_log->Seal();
+  ASSERT_TRUE(
+      event_log->Contains({"thread-b", "test_event-b", Event::Type::END}));
+}
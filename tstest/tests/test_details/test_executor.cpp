@@ -0,0 +1,130 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @brief Scenario Executor Tests
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Enable debug mode if not already enabled
+ *
+ */
+#ifndef __TSTEST_DEBUG__
+#define __TSTEST_DEBUG__
+#endif
+
+#include <tstest/details/executor.hpp>
+
+using namespace tstest::details;
+
+class ScenarioExecutorTestFixture : public ::testing::Test {
+ protected:
+  std::vector<std::unique_ptr<Runner>> runners;
+  Assertor assertor;
+  void SetUp() override {
+    assertor.Insert({{"thread-a", "operation", Event::Type::BEGIN},
+                     {"thread-a", "operation", Event::Type::END}},
+                    []() {});
+  }
+  void TearDown() override {}
+
+  Runner &AddRunner(const OperationName &operation_name) {
+    runners.emplace_back(new Runner());
+    Runner &runner = *runners.back();
+    runner["thread-a"] = [operation_name](ExecutionContext context) {
+      context.LogOperationBegin(std::string(operation_name));
+      context.LogOperationEnd(std::string(operation_name));
+    };
+    return runner;
+  }
+};
+
+TEST_F(ScenarioExecutorTestFixture, TestRun) {
+  ScenarioExecutor executor;
+  for (unsigned int i = 0; i < 16; ++i) {
+    executor.Add("scenario-" + std::to_string(i), AddRunner("operation"),
+                 assertor, 10);
+  }
+
+  ExecutorReport report = executor.Run();
+
+  ASSERT_EQ(report.results.size(), 16);
+  ASSERT_EQ(report.Failed(), 0);
+  for (unsigned int i = 0; i < 16; ++i) {
+    ASSERT_EQ(report.results[i].name, "scenario-" + std::to_string(i));
+    ASSERT_EQ(report.results[i].runs, 10);
+    ASSERT_TRUE(report.results[i].cpus.empty());
+  }
+  ASSERT_GT(report.Throughput(), 0);
+  // Every scenario is run ten times
+  ASSERT_NEAR(report.RunThroughput(), 10 * report.Throughput(),
+              1e-6 * report.RunThroughput());
+}
+
+TEST_F(ScenarioExecutorTestFixture, TestFailedScenario) {
+  ScenarioExecutor executor;
+  executor.Add("passing", AddRunner("operation"), assertor);
+  executor.Add("failing", AddRunner("unexpected"), assertor);
+
+  ExecutorReport report = executor.Run();
+
+  ASSERT_EQ(report.Failed(), 1);
+  ASSERT_TRUE(report.results[0].passed);
+  ASSERT_FALSE(report.results[1].passed);
+  ASSERT_EQ(report.results[1].runs, 0);
+  ASSERT_FALSE(report.results[1].error.empty());
+}
+
+TEST_F(ScenarioExecutorTestFixture, TestReportedFailure) {
+  // Failures are reported without throwing, like gtest assertions
+  std::atomic<size_t> reported(0);
+  Assertor reporting;
+  reporting.Insert({{"thread-a", "operation", Event::Type::BEGIN},
+                    {"thread-a", "operation", Event::Type::END}},
+                   [&]() { ++reported; });
+  ExecutorOptions options;
+  options.failures = [&]() { return reported.load(); };
+  ScenarioExecutor executor(options);
+  executor.Add("reporting", AddRunner("operation"), reporting, 10);
+
+  ExecutorReport report = executor.Run();
+
+  ASSERT_EQ(report.Failed(), 1);
+  ASSERT_FALSE(report.results[0].passed);
+  ASSERT_EQ(report.results[0].runs, 0);
+  ASSERT_EQ(report.results[0].error, "failure reported by the run");
+}
+
+TEST_F(ScenarioExecutorTestFixture, TestIsolate) {
+  ExecutorOptions options;
+  options.isolate = true;
+  ScenarioExecutor executor(options);
+  for (unsigned int i = 0; i < 4; ++i) {
+    executor.Add("scenario-" + std::to_string(i), AddRunner("operation"),
+                 assertor);
+  }
+
+  ExecutorReport report = executor.Run();
+
+  ASSERT_EQ(report.Failed(), 0);
+  const std::vector<CpuId> &available = GetAvailableCpus();
+  for (const auto &result : report.results) {
+    // Single threaded scenarios are pinned to one CPU
+    ASSERT_EQ(result.cpus.size(), 1);
+    ASSERT_TRUE(std::find(available.begin(), available.end(),
+                          result.cpus[0]) != available.end());
+  }
+}
@@ -0,0 +1,96 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @brief Latency Report Tests
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief Enable debug mode if not already enabled
+ *
+ */
+#ifndef __TSTEST_DEBUG__
+#define __TSTEST_DEBUG__
+#endif
+
+#include <tstest/details/latency.hpp>
+
+using namespace tstest::details;
+
+TEST(LatencyHistogramTest, TestPercentile) {
+  LatencyHistogram histogram;
+  for (unsigned int i = 1; i <= 100; ++i) {
+    histogram.Add(i);
+  }
+
+  ASSERT_EQ(histogram.Count(), 100);
+  ASSERT_EQ(histogram.Percentile(50), 50);
+  ASSERT_EQ(histogram.Percentile(99), 99);
+  ASSERT_EQ(histogram.Min(), 1);
+  ASSERT_EQ(histogram.Max(), 100);
+  ASSERT_DOUBLE_EQ(histogram.Mean(), 50.5);
+}
+
+TEST(LatencyHistogramTest, TestBuckets) {
+  LatencyHistogram histogram;
+  histogram.Add(0.5);
+  histogram.Add(1);
+  histogram.Add(3);
+  histogram.Add(3.5);
+
+  ASSERT_EQ(histogram.GetBuckets(), std::vector<size_t>({1, 1, 2}));
+}
+
+TEST(LatencyHistogramTest, TestEmpty) {
+  LatencyHistogram histogram;
+
+  ASSERT_EQ(histogram.Count(), 0);
+  ASSERT_EQ(histogram.Percentile(50), 0);
+}
+
+TEST(LatencyReportTest, TestAdd) {
+  EventList event_list;
+  event_list.push_back({"thread-a", "test_event-a", Event::Type::BEGIN}, 100);
+  event_list.push_back({"thread-b", "test_event-a", Event::Type::BEGIN}, 110);
+  event_list.push_back({"thread-a", "test_event-a", Event::Type::END}, 130);
+  event_list.push_back({"thread-b", "test_event-a", Event::Type::END}, 210);
+  event_list.push_back({"thread-a", "test_event-b", Event::Type::BEGIN}, 300);
+  event_list.push_back({"thread-a", "test_event-b", Event::Type::END}, 305);
+  // Unmatched events are ignored
+  event_list.push_back({"thread-a", "test_event-c", Event::Type::END}, 400);
+  event_list.push_back({"thread-a", "test_event-c", Event::Type::BEGIN}, 410);
+
+  LatencyReport report;
+  report.Add(event_list);
+
+  const LatencyHistogram &histogram_a = report.Get("test_event-a");
+  ASSERT_EQ(histogram_a.Count(), 2);
+  ASSERT_DOUBLE_EQ(histogram_a.Min(), Clock::ToNanoseconds(30));
+  ASSERT_DOUBLE_EQ(histogram_a.Max(), Clock::ToNanoseconds(100));
+  ASSERT_EQ(report.Get("test_event-b").Count(), 1);
+  ASSERT_EQ(report.Get("test_event-c").Count(), 0);
+  ASSERT_EQ(report.GetHistograms().size(), 2);
+}
+
+TEST(LatencyReportTest, TestToString) {
+  EventList event_list;
+  event_list.push_back({"thread-a", "test_event-a", Event::Type::BEGIN}, 0);
+  event_list.push_back({"thread-a", "test_event-a", Event::Type::END}, 0);
+
+  LatencyReport report;
+  report.Add(event_list);
+  std::string str = report.ToString();
+
+  ASSERT_NE(str.find("p99"), std::string::npos);
+  ASSERT_NE(str.find("test_event-a"), std::string::npos);
+}
@@ -0,0 +1,89 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @brief StreamingMatcher Class Tests
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+/**
+ * @brief Enable debug mode if not already enabled
+ *
+ */
+#ifndef __TSTEST_DEBUG__
+#define __TSTEST_DEBUG__
+#endif
+
+#include <tstest/details/matcher.hpp>
+
+using namespace tstest::details;
+
+class StreamingMatcherTestFixture : public ::testing::Test {
+ protected:
+  std::unique_ptr<Assertor> assertor;
+  std::unique_ptr<StreamingMatcher> matcher;
+  void SetUp() override {
+    // Setup assertor with two event lists sharing a prefix
+    assertor = std::make_unique<Assertor>();
+    assertor->Insert({{"thread-a", "test_event-a", Event::Type::BEGIN},
+                      {"thread-a", "test_event-a", Event::Type::END}},
+                     []() {});
+    assertor->Insert({{"thread-a", "test_event-a", Event::Type::BEGIN},
+                      {"thread-b", "test_event-b", Event::Type::BEGIN}},
+                     []() {});
+
+    // Setup matcher
+    matcher = std::make_unique<StreamingMatcher>(*assertor);
+  }
+  void TearDown() override {}
+};
+
+TEST_F(StreamingMatcherTestFixture, TestSize) {
+  // Root, shared prefix and one node for each distinct suffix
+  ASSERT_EQ(matcher->Size(), 4);
+}
+
+TEST_F(StreamingMatcherTestFixture, TestMatch) {
+  ASSERT_TRUE(
+      matcher->Advance({"thread-a", "test_event-a", Event::Type::BEGIN}));
+  ASSERT_FALSE(matcher->IsMatch());
+  ASSERT_TRUE(matcher->Advance({"thread-a", "test_event-a", Event::Type::END}));
+  ASSERT_TRUE(matcher->IsMatch());
+  ASSERT_EQ(matcher->GetDepth(), 2);
+}
+
+TEST_F(StreamingMatcherTestFixture, TestNoMatch) {
+  ASSERT_FALSE(
+      matcher->Advance({"thread-b", "test_event-b", Event::Type::BEGIN}));
+  ASSERT_TRUE(matcher->IsDead());
+  ASSERT_FALSE(matcher->IsMatch());
+  // Stays dead once the prefix has left the table
+  ASSERT_FALSE(
+      matcher->Advance({"thread-a", "test_event-a", Event::Type::BEGIN}));
+
+  matcher->Reset();
+  ASSERT_FALSE(matcher->IsDead());
+  ASSERT_TRUE(
+      matcher->Advance({"thread-a", "test_event-a", Event::Type::BEGIN}));
+}
+
+TEST_F(StreamingMatcherTestFixture, TestListener) {
+  EventLog event_log;
+  event_log.AddListener(matcher.get());
+
+  event_log.Push({"thread-a", "test_event-a", Event::Type::BEGIN});
+  ASSERT_FALSE(event_log.IsCancelled());
+  event_log.Push({"thread-a", "test_event-b", Event::Type::BEGIN});
+  ASSERT_TRUE(event_log.IsCancelled());
+
+  event_log.RemoveListener(matcher.get());
+}
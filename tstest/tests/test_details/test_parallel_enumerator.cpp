@@ -0,0 +1,131 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @brief Parallel Enumerator Tests
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief Enable debug mode if not already enabled
+ *
+ */
+#ifndef __TSTEST_DEBUG__
+#define __TSTEST_DEBUG__
+#endif
+
+#include <tstest/details/algorithm.hpp>
+#include <tstest/details/assertor.hpp>
+#include <tstest/details/parallel_enumerator.hpp>
+#include <tstest/details/schedule_space.hpp>
+
+using namespace tstest::details;
+
+class ParallelEnumeratorTestFixture : public ::testing::Test {
+ protected:
+  EventList event_list;
+  void SetUp() override {
+    event_list = {{"1", "a", Event::Type::BEGIN},
+                  {"2", "a", Event::Type::BEGIN},
+                  {"1", "a", Event::Type::END},
+                  {"3", "b", Event::Type::BEGIN},
+                  {"2", "a", Event::Type::END},
+                  {"1", "b", Event::Type::BEGIN},
+                  {"3", "b", Event::Type::END},
+                  {"2", "b", Event::Type::BEGIN}};
+  }
+  void TearDown() override {}
+
+  /**
+   * @brief Get the ranks of the schedules visited by a parallel enumerator,
+   * sorted.
+   *
+   */
+  std::vector<uint64_t> Visit(const ParallelOptions &options,
+                              ReductionReport &report) {
+    ScheduleSpace space(event_list);
+    std::mutex lock;
+    std::vector<uint64_t> ranks;
+    ParallelEnumerator enumerator(event_list, options);
+    report = enumerator.Run([&](const EventList &schedule, size_t worker) {
+      ASSERT_LT(worker, options.workers);
+      uint64_t rank = space.Rank(schedule);
+      std::lock_guard<std::mutex> guard(lock);
+      ranks.push_back(rank);
+    });
+    std::sort(ranks.begin(), ranks.end());
+    return ranks;
+  }
+};
+
+TEST_F(ParallelEnumeratorTestFixture, TestRun) {
+  // 8! / (3! * 3! * 2!)
+  std::vector<uint64_t> expected(560);
+  for (uint64_t rank = 0; rank < expected.size(); ++rank) {
+    expected[rank] = rank;
+  }
+  for (size_t workers : {1, 2, 4}) {
+    for (uint64_t grain : {0, 1, 16, 1024}) {
+      ParallelOptions options;
+      options.workers = workers;
+      options.grain = grain;
+      ReductionReport report;
+      ASSERT_EQ(Visit(options, report), expected);
+      ASSERT_EQ(report.total, 560);
+      ASSERT_EQ(report.explored, 560);
+    }
+  }
+}
+
+TEST_F(ParallelEnumeratorTestFixture, TestRunReduced) {
+  ScheduleOptions schedule;
+  schedule.independence.Add("a", "b");
+  ScheduleSpace space(event_list);
+  std::vector<EventList> reduced;
+  GetAllSchedules()(event_list, reduced, schedule);
+  std::vector<uint64_t> expected;
+  for (const auto &schedule : reduced) {
+    expected.push_back(space.Rank(schedule));
+  }
+  std::sort(expected.begin(), expected.end());
+
+  ParallelOptions options;
+  options.workers = 3;
+  options.grain = 8;
+  options.schedule = schedule;
+  ReductionReport report;
+  ASSERT_EQ(Visit(options, report), expected);
+  ASSERT_EQ(report.explored, reduced.size());
+  ASSERT_LT(report.explored, report.total);
+}
+
+TEST_F(ParallelEnumeratorTestFixture, TestCoverageCheck) {
+  std::vector<EventList> schedules;
+  GetAllSchedules()(event_list, schedules);
+  Assertor assertor;
+  assertor.InsertMany(schedules, []() {});
+
+  ParallelOptions options;
+  options.workers = 4;
+  options.grain = 4;
+  ParallelEnumerator enumerator(event_list, options);
+  auto check = [&](const EventList &schedule, size_t) {
+    assertor.Get(schedule);
+  };
+  ASSERT_EQ(enumerator.Run(check).explored, 560);
+
+  // Missing schedules stop the workers and the error is rethrown
+  assertor.Remove(schedules[300]);
+  ASSERT_THROW(enumerator.Run(check), std::out_of_range);
+}
@@ -0,0 +1,88 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @brief Placement Planner Tests
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+/**
+ * @brief Enable debug mode if not already enabled
+ *
+ */
+#ifndef __TSTEST_DEBUG__
+#define __TSTEST_DEBUG__
+#endif
+
+#include <tstest/details/placement.hpp>
+
+using namespace tstest::details;
+
+class PlacementPlannerTestFixture : public ::testing::Test {
+ protected:
+  std::vector<CpuInfo> topology;
+  void SetUp() override {
+    // 2 sockets with 2 cores of 2 SMT siblings each, numbered like Linux
+    for (CpuId id = 0; id < 8; ++id) {
+      CpuInfo info;
+      info.id = id;
+      info.socket = (id / 2) % 2;
+      info.node = info.socket;
+      info.core = id % 2;
+      topology.push_back(info);
+    }
+  }
+  void TearDown() override {}
+
+  std::vector<CpuId> PlaceAll(PlacementPlanner &planner,
+                              const Placement &placement, size_t count) {
+    std::vector<CpuId> cpus;
+    for (size_t i = 0; i < count; ++i) {
+      cpus.push_back(planner.Place(placement).id);
+    }
+    return cpus;
+  }
+};
+
+TEST_F(PlacementPlannerTestFixture, TestPin) {
+  PlacementPlanner planner(topology);
+  planner.Start(0);
+  ASSERT_EQ(PlaceAll(planner, Placement::Pin(5), 2),
+            std::vector<CpuId>({5, 5}));
+  ASSERT_THROW(planner.Place(Placement::Pin(8)), InvalidPlacement);
+}
+
+TEST_F(PlacementPlannerTestFixture, TestSpread) {
+  PlacementPlanner planner(topology);
+  planner.Start(0);
+  // Alternate sockets, distinct cores before siblings
+  std::vector<CpuId> cpus = PlaceAll(planner, Placement::Spread(), 8);
+  ASSERT_EQ(cpus, std::vector<CpuId>({0, 2, 1, 3, 4, 6, 5, 7}));
+}
+
+TEST_F(PlacementPlannerTestFixture, TestSiblings) {
+  PlacementPlanner planner(topology);
+  planner.Start(0);
+  std::vector<CpuId> cpus = PlaceAll(planner, Placement::Siblings(), 4);
+  ASSERT_EQ(cpus, std::vector<CpuId>({0, 4, 1, 5}));
+  ASSERT_EQ(topology[cpus[0]].core, topology[cpus[1]].core);
+  ASSERT_EQ(topology[cpus[0]].socket, topology[cpus[1]].socket);
+}
+
+TEST_F(PlacementPlannerTestFixture, TestRotate) {
+  PlacementPlanner planner(topology);
+  planner.Start(0);
+  ASSERT_EQ(PlaceAll(planner, Placement::Rotate(), 2),
+            std::vector<CpuId>({0, 1}));
+  planner.Start(7);
+  ASSERT_EQ(PlaceAll(planner, Placement::Rotate(), 2),
+            std::vector<CpuId>({7, 0}));
+}
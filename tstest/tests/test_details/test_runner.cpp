@@ -12,8 +12,14 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
+#include <thread>
 
 /**
  * @brief Enable debug mode if not already enabled
@@ -23,6 +29,7 @@
 #define __TSTEST_DEBUG__
 #endif
 
+#include <tstest/details/latency.hpp>
 #include <tstest/details/runner.hpp>
 
 using namespace tstest::details;
@@ -86,3 +93,355 @@ TEST_F(RunnerTestFixture, TestRun) {
   ASSERT_TRUE(event_log_.Contains(
       {"test-thread-b", "test_operation-b", Event::Type::BEGIN}));
 }
+
+TEST_F(RunnerTestFixture, TestRunBuffered) {
+  RunnerOptions options;
+  options.log_mode = EventLog::Mode::BUFFERED;
+  Runner buffered_runner(options);
+
+  // Inserting thread functions
+  buffered_runner["test-thread-a"] = [&](ExecutionContext context) {
+    context.LogOperationBegin("test_operation-a");
+    context.LogOperationEnd("test_operation-a");
+  };
+  buffered_runner["test-thread-b"] = [&](ExecutionContext context) {
+    context.LogOperationBegin("test_operation-b");
+    context.LogOperationEnd("test_operation-b");
+  };
+
+  // Running thread functions
+  buffered_runner.Run();
+
+  // Assert operational event logs for the two threads
+  const EventLog &event_log_ = buffered_runner.GetEventLog();
+  ASSERT_EQ(event_log_.Size(), 4);
+  ASSERT_TRUE(event_log_.Contains(
+      {"test-thread-a", "test_operation-a", Event::Type::BEGIN}));
+  ASSERT_TRUE(event_log_.Contains(
+      {"test-thread-b", "test_operation-b", Event::Type::END}));
+}
+
+TEST_F(RunnerTestFixture, TestRunSealsLog) {
+  (*runner)["test-thread-a"] = [&](ExecutionContext context) {
+    context.LogOperationBegin("test_operation-a");
+  };
+
+  runner->Run();
+  ASSERT_TRUE(runner->GetEventLog().IsSealed());
+  ASSERT_EQ(runner->GetEventLog().View().size(), 1);
+
+  // A subsequent run reopens the log
+  runner->Run();
+  ASSERT_TRUE(runner->GetEventLog().IsSealed());
+  ASSERT_EQ(runner->GetEventLog().View().size(), 2);
+}
+
+TEST_F(RunnerTestFixture, TestRunWithAssertor) {
+  bool flag = false;  // Flag indicating if an assertion function was executed
+  Assertor assertor;
+  assertor.Insert({{"test-thread-a", "test_operation-a", Event::Type::BEGIN},
+                   {"test-thread-a", "test_operation-a", Event::Type::END}},
+                  [&]() { flag = true; });
+
+  (*runner)["test-thread-a"] = [&](ExecutionContext context) {
+    context.LogOperationBegin("test_operation-a");
+    context.LogOperationEnd("test_operation-a");
+  };
+
+  runner->Run(assertor);
+  ASSERT_TRUE(flag);
+  ASSERT_FALSE(runner->GetEventLog().IsCancelled());
+}
+
+TEST_F(RunnerTestFixture, TestRunWithAssertorStopsEarly) {
+  const unsigned int num_operations = 1000;
+  Assertor assertor;
+  assertor.Insert({{"test-thread-a", "test_operation-a", Event::Type::BEGIN},
+                   {"test-thread-a", "test_operation-a", Event::Type::END}},
+                  []() {});
+
+  (*runner)["test-thread-a"] = [&](ExecutionContext context) {
+    for (unsigned int i = 0; i < num_operations; ++i) {
+      context.LogOperationBegin("test_operation-b");
+      context.LogOperationEnd("test_operation-b");
+    }
+  };
+
+  ASSERT_THROW(runner->Run(assertor), NoAssertionFunctionFound);
+  // The run is cancelled right after the first unmatched event
+  ASSERT_TRUE(runner->GetEventLog().IsCancelled());
+  ASSERT_EQ(runner->GetEventLog().Size(), 1);
+}
+
+TEST_F(RunnerTestFixture, TestRunTimestamped) {
+  for (auto log_mode : {EventLog::Mode::SHARED, EventLog::Mode::BUFFERED}) {
+    RunnerOptions options;
+    options.log_mode = log_mode;
+    options.timestamps = true;
+    Runner timestamped_runner(options);
+
+    timestamped_runner["test-thread-a"] = [&](ExecutionContext context) {
+      context.LogOperationBegin("test_operation-a");
+      context.LogOperationEnd("test_operation-a");
+    };
+    timestamped_runner.Run();
+
+    const EventList &events = timestamped_runner.GetEventLog().View();
+    ASSERT_TRUE(events.HasTimestamps());
+    ASSERT_LE(events.GetTimestamps()[0], events.GetTimestamps()[1]);
+  }
+}
+
+TEST_F(RunnerTestFixture, TestRunTimestampedExcludesLogWait) {
+  // Listener holding the log lock while it handles the END of "hold"
+  struct SlowListener : EventListener {
+    std::atomic<bool> holding{false};
+    bool OnEvent(const Event &event, Timestamp) override {
+      if (event == Event("test-thread-b", "hold", Event::Type::END)) {
+        holding = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      }
+      return true;
+    }
+  } listener;
+
+  RunnerOptions options;
+  options.timestamps = true;
+  Runner timestamped_runner(options);
+  timestamped_runner.AddListener(&listener);
+  timestamped_runner["test-thread-a"] = [&](ExecutionContext context) {
+    while (!listener.holding) {
+      std::this_thread::yield();
+    }
+    // The BEGIN waits for the lock held by the listener
+    context.LogOperationBegin("test_operation");
+    context.LogOperationEnd("test_operation");
+  };
+  timestamped_runner["test-thread-b"] = [&](ExecutionContext context) {
+    context.LogOperationBegin("hold");
+    context.LogOperationEnd("hold");
+  };
+  timestamped_runner.Run();
+  timestamped_runner.RemoveListener(&listener);
+
+  LatencyReport report;
+  report.Add(timestamped_runner.GetEventLog().View());
+  ASSERT_EQ(report.Get("test_operation").Count(), 1);
+  ASSERT_LT(report.Get("test_operation").Max(), 25e6);
+}
+
+TEST_F(RunnerTestFixture, TestRunReuseThreads) {
+  for (auto log_mode : {EventLog::Mode::SHARED, EventLog::Mode::BUFFERED}) {
+    RunnerOptions options;
+    options.log_mode = log_mode;
+    options.reuse_threads = true;
+    Runner pooled_runner(options);
+
+    std::mutex lock;
+    std::set<std::thread::id> thread_ids;
+    auto thread_function = [&](ExecutionContext context) {
+      {
+        std::lock_guard<std::mutex> guard(lock);
+        thread_ids.insert(std::this_thread::get_id());
+      }
+      context.LogOperationBegin("test_operation");
+      context.LogOperationEnd("test_operation");
+    };
+    pooled_runner["test-thread-a"] = thread_function;
+    pooled_runner["test-thread-b"] = thread_function;
+
+    for (unsigned int i = 0; i < 100; ++i) {
+      pooled_runner.Run();
+      // Each iteration starts from an empty log
+      ASSERT_EQ(pooled_runner.GetEventLog().View().size(), 4);
+    }
+    // The same two threads ran all the iterations
+    ASSERT_EQ(thread_ids.size(), 2);
+  }
+}
+
+TEST_F(RunnerTestFixture, TestStartSpread) {
+  // A single thread has no spread
+  (*runner)["test-thread-a"] = [&](ExecutionContext) {};
+  runner->Run();
+  ASSERT_EQ(runner->GetStartSpread(), 0);
+
+  // Thread functions released together all start before any of them finishes
+  const unsigned int num_threads = 4;
+  std::atomic<unsigned int> started(0);
+  std::atomic<bool> overlapped(true);
+  for (unsigned int i = 0; i < num_threads; ++i) {
+    (*runner)["test-thread-" + std::to_string(i)] = [&](ExecutionContext) {
+      ++started;
+      auto deadline =
+          std::chrono::steady_clock::now() + std::chrono::seconds(10);
+      while (started.load() < num_threads) {
+        if (std::chrono::steady_clock::now() > deadline) {
+          overlapped = false;
+          break;
+        }
+      }
+    };
+  }
+  runner->Remove("test-thread-a");
+  runner->Run();
+
+  ASSERT_TRUE(overlapped);
+  ASSERT_GE(runner->GetStartSpread(), 0);
+}
+
+TEST_F(RunnerTestFixture, TestReplicate) {
+  const unsigned int num_replicas = 8;
+  std::mutex lock;
+  std::set<size_t> indices;
+  runner->Replicate("writer", num_replicas) = [&](ExecutionContext context) {
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      indices.insert(context.GetReplicaIndex());
+    }
+    context.LogOperationBegin("write");
+  };
+  (*runner)["reader"] = [&](ExecutionContext context) {
+    ASSERT_EQ(context.GetReplicaIndex(), 0);
+    context.LogOperationBegin("read");
+  };
+
+  ASSERT_EQ(runner->GetThreadCount(), num_replicas + 1);
+  runner->Run();
+
+  ASSERT_EQ(indices.size(), num_replicas);
+  ASSERT_EQ(*indices.rbegin(), num_replicas - 1);
+  const EventLog &event_log_ = runner->GetEventLog();
+  ASSERT_EQ(event_log_.Size(), num_replicas + 1);
+  for (unsigned int i = 0; i < num_replicas; ++i) {
+    ASSERT_TRUE(event_log_.Contains(
+        {GetReplicaName("writer", i), "write", Event::Type::BEGIN}));
+  }
+
+  // Replicas form one group of interchangeable threads
+  SymmetryGroups symmetry = runner->GetSymmetry();
+  ASSERT_EQ(symmetry.GetGroups().size(), 1);
+  ASSERT_EQ(symmetry.GetGroups()[0].size(), num_replicas);
+}
+
+TEST_F(RunnerTestFixture, TestPlacement) {
+  const std::vector<CpuId> &available = GetAvailableCpus();
+  runner->Replicate("writer", 2) = [&](ExecutionContext context) {
+    context.LogOperationBegin("write");
+  };
+  (*runner)["reader"] = [&](ExecutionContext context) {
+    context.LogOperationBegin("read");
+  };
+  runner->SetPlacement("writer", Placement::Pin(available.back()));
+  runner->SetPlacement("reader", Placement::Rotate());
+
+  runner->Run();
+  const auto &placement = runner->GetPlacement();
+  ASSERT_EQ(placement.size(), 3);
+  ASSERT_EQ(placement.at("writer#0").id, available.back());
+  ASSERT_EQ(placement.at("writer#1").id, available.back());
+  CpuId first = placement.at("reader").id;
+
+  runner->Run();
+  ASSERT_EQ(runner->GetPlacement().at("reader").id,
+            available[(std::find(available.begin(), available.end(), first) -
+                       available.begin() + 1) %
+                      available.size()]);
+
+  runner->SetPlacement("writer", Placement::Pin(1U << 20));
+  ASSERT_THROW(runner->Run(), InvalidPlacement);
+}
+
+TEST(RunnerDeadlineTest, TestDeadlineCancel) {
+  RunnerOptions options;
+  options.deadline = std::chrono::milliseconds(50);
+  options.deadline_action = Watchdog::Action::CANCEL;
+  Runner runner(options);
+  runner["thread-a"] = [&](ExecutionContext context) {
+    context.LogOperationBegin("acquire");
+    // Livelock: poll forever until the run is cancelled
+    while (true) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      context.LogOperationBegin("poll");
+      context.LogOperationEnd("poll");
+    }
+  };
+  runner["thread-b"] = [&](ExecutionContext context) {
+    context.LogOperationBegin("work");
+    context.LogOperationEnd("work");
+  };
+
+  std::string report;
+  try {
+    runner.Run();
+  } catch (const RunTimedOut &error) {
+    report = error.what();
+  }
+  ASSERT_NE(report.find("Unfinished threads:\n  thread-a\n"),
+            std::string::npos);
+  ASSERT_EQ(report.find("  thread-b\n"), std::string::npos);
+  ASSERT_NE(report.find("Operations begun but not ended:\n  " +
+                        Event("thread-a", "acquire", Event::Type::BEGIN)
+                            .ToString()),
+            std::string::npos);
+  ASSERT_TRUE(runner.GetEventLog().IsCancelled());
+
+  // Runs finishing in time are not affected
+  size_t size = runner.GetEventLog().Size();
+  runner.Remove("thread-a");
+  runner.Run();
+  ASSERT_FALSE(runner.GetEventLog().IsCancelled());
+  ASSERT_EQ(runner.GetEventLog().Size(), size + 2);
+}
+
+TEST(RunnerDeadlineTest, TestDeadlineCancelBuffered) {
+  RunnerOptions options;
+  options.log_mode = EventLog::Mode::BUFFERED;
+  // Small buffers so that the hung thread grows its buffer
+  options.buffer_capacity = 2;
+  options.deadline = std::chrono::milliseconds(50);
+  options.deadline_action = Watchdog::Action::CANCEL;
+  Runner runner(options);
+  runner["thread-a"] = [&](ExecutionContext context) {
+    context.LogOperationBegin("acquire");
+    while (true) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      context.LogOperationBegin("poll");
+      context.LogOperationEnd("poll");
+    }
+  };
+
+  std::string report;
+  try {
+    runner.Run();
+  } catch (const RunTimedOut &error) {
+    report = error.what();
+  }
+  // The report is built from the buffers which are not merged yet
+  ASSERT_NE(report.find("Operations begun but not ended:\n  " +
+                        Event("thread-a", "acquire", Event::Type::BEGIN)
+                            .ToString()),
+            std::string::npos);
+  ASSERT_NE(report.find(Event("thread-a", "poll", Event::Type::END)
+                            .ToString()),
+            std::string::npos);
+}
+
+TEST(RunnerDeadlineTest, TestDeadlineAbort) {
+  GTEST_FLAG_SET(death_test_style, "threadsafe");
+  ASSERT_DEATH(
+      {
+        RunnerOptions options;
+        options.deadline = std::chrono::milliseconds(50);
+        Runner runner(options);
+        std::mutex lock;
+        lock.lock();
+        runner["thread-a"] = [&](ExecutionContext context) {
+          context.LogOperationBegin("acquire");
+          // Deadlock: the lock is never released
+          std::lock_guard<std::mutex> guard(lock);
+        };
+        runner.Run();
+      },
+      "Unfinished threads:\n  thread-a");
+}
@@ -0,0 +1,136 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @brief Schedule Space Tests
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Enable debug mode if not already enabled
+ *
+ */
+#ifndef __TSTEST_DEBUG__
+#define __TSTEST_DEBUG__
+#endif
+
+#include <tstest/details/algorithm.hpp>
+#include <tstest/details/schedule_space.hpp>
+
+using namespace tstest::details;
+
+class ScheduleSpaceTestFixture : public ::testing::Test {
+ protected:
+  EventList event_list;
+  void SetUp() override {
+    // Threads with 3, 2 and 2 events, interleaved in the list
+    event_list = {{"1", "a", Event::Type::BEGIN},
+                  {"2", "a", Event::Type::BEGIN},
+                  {"1", "a", Event::Type::END},
+                  {"3", "b", Event::Type::BEGIN},
+                  {"2", "a", Event::Type::END},
+                  {"1", "b", Event::Type::BEGIN},
+                  {"3", "b", Event::Type::END}};
+  }
+  void TearDown() override {}
+};
+
+TEST_F(ScheduleSpaceTestFixture, TestRankUnrank) {
+  ScheduleSpace space(event_list);
+  std::vector<EventList> schedules;
+  GetAllSchedules()(event_list, schedules);
+
+  // 7! / (3! * 2! * 2!)
+  ASSERT_EQ(space.Count(), 210);
+  ASSERT_EQ(schedules.size(), 210);
+  for (uint64_t rank = 0; rank < schedules.size(); ++rank) {
+    ASSERT_EQ(space.Unrank(rank), schedules[rank]);
+    ASSERT_EQ(space.Rank(schedules[rank]), rank);
+  }
+
+  ASSERT_THROW(space.Unrank(210), std::out_of_range);
+  EventList invalid = schedules[5];
+  invalid.pop_back();
+  ASSERT_THROW(space.Rank(invalid), std::invalid_argument);
+  ASSERT_THROW(space.Rank(std::vector<size_t>(7, 0)), std::invalid_argument);
+}
+
+TEST_F(ScheduleSpaceTestFixture, TestSample) {
+  ScheduleSpace space(event_list);
+  std::mt19937_64 random(42);
+  std::vector<size_t> frequencies(space.Count(), 0);
+  for (int i = 0; i < 21000; ++i) {
+    ++frequencies[space.Rank(space.Sample(random))];
+  }
+  for (auto frequency : frequencies) {
+    ASSERT_GT(frequency, 40);
+    ASSERT_LT(frequency, 180);
+  }
+}
+
+TEST_F(ScheduleSpaceTestFixture, TestOverflow) {
+  EventList large;
+  for (const char *thread : {"1", "2", "3", "4"}) {
+    for (int i = 0; i < 10; ++i) {
+      large.push_back({thread, "a", Event::Type::BEGIN});
+      large.push_back({thread, "a", Event::Type::END});
+    }
+  }
+  // 80! / (20!)^4 is about 1.3e45
+  ASSERT_THROW(ScheduleSpace(large).Count(), ScheduleCountOverflow);
+  ASSERT_EQ(ScheduleEnumerator(large).GetReport().total, UINT64_MAX);
+
+  uint64_t count = 0;
+  ASSERT_TRUE(ScheduleSpace::Multinomial({30, 30}, count));
+  ASSERT_EQ(count, 118264581564861424ULL);
+  ASSERT_FALSE(ScheduleSpace::Multinomial({40, 40}, count));
+}
+
+TEST_F(ScheduleSpaceTestFixture, TestShardByRank) {
+  ScheduleSpace space(event_list);
+  std::vector<EventList> schedules;
+  GetAllSchedules()(event_list, schedules);
+
+  std::vector<EventList> sharded;
+  ScheduleEnumerator enumerator(event_list);
+  for (uint64_t first = 0; first < 210; first += 50) {
+    uint64_t last = first + 50;
+    enumerator.Seek(space.UnrankThreads(first),
+                    last < 210 ? space.UnrankThreads(last)
+                               : std::vector<size_t>());
+    while (enumerator.Next()) {
+      sharded.push_back(enumerator.Get());
+    }
+  }
+  ASSERT_EQ(sharded, schedules);
+
+  // Shards of a reduced enumeration together hold the same schedules
+  ScheduleOptions options;
+  options.independence.Add("a", "b");
+  std::vector<EventList> reduced;
+  GetAllSchedules()(event_list, reduced, options);
+  ASSERT_LT(reduced.size(), schedules.size());
+  std::vector<EventList> reduced_sharded;
+  ScheduleEnumerator reduced_enumerator(event_list, options);
+  for (uint64_t first = 0; first < 210; first += 50) {
+    uint64_t last = first + 50;
+    reduced_enumerator.Seek(space.UnrankThreads(first),
+                            last < 210 ? space.UnrankThreads(last)
+                                       : std::vector<size_t>());
+    while (reduced_enumerator.Next()) {
+      reduced_sharded.push_back(reduced_enumerator.Get());
+    }
+  }
+  ASSERT_EQ(reduced_sharded, reduced);
+}
@@ -0,0 +1,367 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @brief Scheduler Tests
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief Enable debug mode if not already enabled
+ *
+ */
+#ifndef __TSTEST_DEBUG__
+#define __TSTEST_DEBUG__
+#endif
+
+#include <tstest/details/algorithm.hpp>
+#include <tstest/details/runner.hpp>
+
+using namespace tstest::details;
+
+class SchedulerTestFixture : public ::testing::Test {
+ protected:
+  Runner runner;
+  std::vector<EventList> schedules;
+  void SetUp() override {
+    for (auto thread_name : {"thread-a", "thread-b"}) {
+      runner[thread_name] = [&](ExecutionContext context) {
+        context.LogOperationBegin("operation");
+        context.LogOperationEnd("operation");
+      };
+    }
+    GetAllSchedules()({{"thread-a", "operation", Event::Type::BEGIN},
+                       {"thread-a", "operation", Event::Type::END},
+                       {"thread-b", "operation", Event::Type::BEGIN},
+                       {"thread-b", "operation", Event::Type::END}},
+                      schedules);
+  }
+  void TearDown() override {}
+};
+
+TEST_F(SchedulerTestFixture, TestRunSchedule) {
+  for (const auto &schedule : schedules) {
+    ASSERT_TRUE(runner.RunSchedule(schedule));
+    ASSERT_EQ(runner.GetEventLog().View(), schedule);
+  }
+}
+
+TEST_F(SchedulerTestFixture, TestRunScheduleDiverged) {
+  // The threads never log the END event first
+  EventList schedule = {{"thread-a", "operation", Event::Type::END},
+                        {"thread-a", "operation", Event::Type::BEGIN}};
+  ASSERT_FALSE(runner.RunSchedule(schedule));
+  ASSERT_TRUE(runner.GetEventLog().IsCancelled());
+
+  // The schedule ends before the threads are done
+  ASSERT_FALSE(runner.RunSchedule(EventList(schedules[0].begin(),
+                                            schedules[0].begin() + 2)));
+
+  // The threads are done before the schedule ends
+  EventList longer = schedules[0];
+  longer.push_back({"thread-a", "operation", Event::Type::BEGIN});
+  ASSERT_FALSE(runner.RunSchedule(longer));
+}
+
+TEST_F(SchedulerTestFixture, TestSequentialScheduler) {
+  SequentialScheduler sequential;
+  runner.Run(sequential);
+
+  const EventList &events = runner.GetEventLog().View();
+  ASSERT_EQ(events.size(), 4);
+  ASSERT_EQ(events[0].GetThreadId(), events[1].GetThreadId());
+  ASSERT_EQ(events[2].GetThreadId(), events[3].GetThreadId());
+}
+
+TEST_F(SchedulerTestFixture, TestRunAllSchedules) {
+  std::vector<unsigned int> calls(schedules.size(), 0);
+  Assertor assertor;
+  for (size_t i = 0; i < schedules.size(); ++i) {
+    assertor.Insert(schedules[i], [&calls, i]() { ++calls[i]; });
+  }
+
+  ASSERT_EQ(runner.RunAllSchedules(assertor), 6);
+  // Each schedule is run exactly once
+  ASSERT_EQ(calls, std::vector<unsigned int>(schedules.size(), 1));
+}
+
+TEST(SchedulerTest, TestFindLostUpdate) {
+  Runner runner;
+  int counter = 0;
+  for (auto thread_name : {"thread-a", "thread-b"}) {
+    runner[thread_name] = [&](ExecutionContext context) {
+      int value;
+      context.LogOperationBegin("read");
+      value = counter;
+      context.LogOperationEnd("read");
+      context.LogOperationBegin("write");
+      counter = value + 1;
+      context.LogOperationEnd("write");
+    };
+  }
+  std::vector<EventList> schedules;
+  GetAllSchedules()({{"thread-a", "read", Event::Type::BEGIN},
+                     {"thread-a", "read", Event::Type::END},
+                     {"thread-a", "write", Event::Type::BEGIN},
+                     {"thread-a", "write", Event::Type::END},
+                     {"thread-b", "read", Event::Type::BEGIN},
+                     {"thread-b", "read", Event::Type::END},
+                     {"thread-b", "write", Event::Type::BEGIN},
+                     {"thread-b", "write", Event::Type::END}},
+                    schedules);
+  unsigned int lost_updates = 0;
+  Assertor assertor;
+  assertor.InsertMany(schedules, [&]() {
+    lost_updates += counter == 1 ? 1 : 0;
+    counter = 0;
+  });
+
+  ASSERT_EQ(runner.RunAllSchedules(schedules, assertor), 70);
+  // Schedules where both reads happen before either write lose an update
+  ASSERT_GT(lost_updates, 0);
+  ASSERT_LT(lost_updates, 70);
+}
+
+TEST_F(SchedulerTestFixture, TestPCTSchedulerReproducible) {
+  std::set<std::vector<SymbolId>> observed;
+  auto last_run = [&]() {
+    const EventList &events = runner.GetEventLog().View();
+    return EventList(events.end() - 4, events.end());
+  };
+  for (uint64_t seed = 1; seed <= 20; ++seed) {
+    PCTScheduler pct(seed, 1, 4);
+    runner.Run(pct);
+    EventList first = last_run();
+    runner.Run(pct);
+    // The same seed gives the same schedule
+    ASSERT_EQ(last_run(), first);
+    observed.insert(
+        std::vector<SymbolId>(first.GetThreadIds().begin(),
+                              first.GetThreadIds().end()));
+    ASSERT_EQ(pct.GetSeed(), seed);
+    ASSERT_TRUE(std::find(schedules.begin(), schedules.end(), first) !=
+                schedules.end());
+  }
+  // Different seeds explore different schedules
+  ASSERT_GT(observed.size(), 1);
+}
+
+/**
+ * @brief PCT scheduler exposing its policy.
+ *
+ */
+class PCTPolicy : public PCTScheduler {
+ public:
+  using PCTScheduler::OnStart;
+  using PCTScheduler::PCTScheduler;
+  using PCTScheduler::Pick;
+};
+
+TEST(SchedulerTest, TestPCTSchedulerPortable) {
+  // Draws only depend on the output of the generator, which the standard fixes
+  std::mt19937_64 random(7);
+  std::vector<uint64_t> draws;
+  for (int i = 0; i < 6; ++i) {
+    draws.push_back(DrawBelow(random, 10));
+  }
+  ASSERT_EQ(draws, std::vector<uint64_t>({5, 0, 8, 6, 1, 8}));
+
+  // So does the policy of a seed, on every standard library
+  PCTPolicy pct(5, 2, 6);
+  pct.OnStart(3);
+  std::vector<size_t> picks;
+  for (int i = 0; i < 6; ++i) {
+    picks.push_back(pct.Pick({0, 1, 2}));
+  }
+  ASSERT_EQ(picks, std::vector<size_t>({0, 0, 2, 2, 1, 1}));
+}
+
+TEST(SchedulerTest, TestRunPCTFindsLostUpdate) {
+  Runner runner;
+  int counter = 0;
+  for (auto thread_name : {"thread-a", "thread-b"}) {
+    runner[thread_name] = [&](ExecutionContext context) {
+      int value;
+      context.LogOperationBegin("read");
+      value = counter;
+      context.LogOperationEnd("read");
+      context.LogOperationBegin("write");
+      counter = value + 1;
+      context.LogOperationEnd("write");
+    };
+  }
+  std::vector<EventList> schedules;
+  GetAllSchedules()({{"thread-a", "read", Event::Type::BEGIN},
+                     {"thread-a", "read", Event::Type::END},
+                     {"thread-a", "write", Event::Type::BEGIN},
+                     {"thread-a", "write", Event::Type::END},
+                     {"thread-b", "read", Event::Type::BEGIN},
+                     {"thread-b", "read", Event::Type::END},
+                     {"thread-b", "write", Event::Type::BEGIN},
+                     {"thread-b", "write", Event::Type::END}},
+                    schedules);
+  Assertor assertor;
+  assertor.InsertMany(schedules, [&]() {
+    int value = counter;
+    counter = 0;
+    if (value != 2) {
+      throw std::runtime_error("lost update");
+    }
+  });
+  PCTOptions options;
+  options.seed = 42;
+
+  uint64_t seed = 0;
+  try {
+    runner.RunPCT(assertor, options);
+  } catch (const SeededRunFailed &error) {
+    seed = error.GetSeed();
+  }
+  ASSERT_NE(seed, 0);
+
+  // The failed run is reproduced from its seed alone
+  counter = 0;
+  options.seed = seed;
+  options.iterations = 1;
+  try {
+    runner.RunPCT(assertor, options);
+    FAIL();
+  } catch (const SeededRunFailed &error) {
+    ASSERT_EQ(error.GetSeed(), seed);
+  }
+}
+
+TEST(SchedulerTest, TestRunPCTReportsSeeds) {
+  Runner runner;
+  int counter = 0;
+  for (auto thread_name : {"thread-a", "thread-b"}) {
+    runner[thread_name] = [&](ExecutionContext context) {
+      int value;
+      context.LogOperationBegin("read");
+      value = counter;
+      context.LogOperationEnd("read");
+      context.LogOperationBegin("write");
+      counter = value + 1;
+      context.LogOperationEnd("write");
+    };
+  }
+  std::vector<EventList> schedules;
+  GetAllSchedules()({{"thread-a", "read", Event::Type::BEGIN},
+                     {"thread-a", "read", Event::Type::END},
+                     {"thread-a", "write", Event::Type::BEGIN},
+                     {"thread-a", "write", Event::Type::END},
+                     {"thread-b", "read", Event::Type::BEGIN},
+                     {"thread-b", "read", Event::Type::END},
+                     {"thread-b", "write", Event::Type::BEGIN},
+                     {"thread-b", "write", Event::Type::END}},
+                    schedules);
+  // Failures are reported without throwing, like gtest assertions
+  size_t reported = 0;
+  Assertor assertor;
+  assertor.InsertMany(schedules, [&]() {
+    reported += counter != 2;
+    counter = 0;
+  });
+  std::vector<uint64_t> seeds;
+  PCTOptions options;
+  options.seed = 42;
+  options.listener = [&](uint64_t seed, size_t iteration) {
+    ASSERT_EQ(iteration, seeds.size());
+    seeds.push_back(seed);
+  };
+  options.failures = [&]() { return reported; };
+  // A failure reported before the runs does not mask theirs
+  reported = 1;
+
+  uint64_t seed = 0;
+  try {
+    runner.RunPCT(assertor, options);
+  } catch (const SeededRunFailed &error) {
+    seed = error.GetSeed();
+  }
+  ASSERT_FALSE(seeds.empty());
+  ASSERT_EQ(seed, seeds.back());
+  for (size_t i = 0; i < seeds.size(); ++i) {
+    ASSERT_EQ(seeds[i], GetRunSeed(42, i));
+  }
+
+  ASSERT_EQ(reported, 2);
+
+  // The failed run is reproduced from its seed alone
+  counter = 0;
+  seeds.clear();
+  options.seed = seed;
+  options.iterations = 1;
+  ASSERT_THROW(runner.RunPCT(assertor, options), SeededRunFailed);
+  ASSERT_EQ(seeds, std::vector<uint64_t>({seed}));
+}
+
+TEST(SchedulerTest, TestRunAllSchedulesReplicas) {
+  Runner runner;
+  runner.Replicate("writer", 3) = [&](ExecutionContext context) {
+    context.LogOperationBegin("write");
+    context.LogOperationEnd("write");
+  };
+  std::vector<EventList> schedules;
+  GetAllSchedules()({{"writer#0", "write", Event::Type::BEGIN},
+                     {"writer#0", "write", Event::Type::END},
+                     {"writer#1", "write", Event::Type::BEGIN},
+                     {"writer#1", "write", Event::Type::END},
+                     {"writer#2", "write", Event::Type::BEGIN},
+                     {"writer#2", "write", Event::Type::END}},
+                    schedules, runner.GetSymmetry());
+  // 6! / (2! * 2! * 2!) schedules of which one in 3! is canonical
+  ASSERT_EQ(schedules.size(), 15);
+  unsigned int calls = 0;
+  Assertor assertor;
+  assertor.SetSymmetry(runner.GetSymmetry());
+  assertor.InsertMany(schedules, [&]() { ++calls; });
+
+  ASSERT_EQ(runner.RunAllSchedules(assertor), 15);
+  ASSERT_EQ(calls, 15);
+}
+
+TEST(SchedulerTest, TestRunAllSchedulesReduced) {
+  Runner runner;
+  runner["thread-a"] = [&](ExecutionContext context) {
+    context.LogOperationBegin("write-a");
+    context.LogOperationEnd("write-a");
+  };
+  runner["thread-b"] = [&](ExecutionContext context) {
+    context.LogOperationBegin("write-b");
+    context.LogOperationEnd("write-b");
+  };
+  ScheduleOptions options;
+  options.independence.Add("write-a", "write-b");
+  unsigned int calls = 0;
+  Assertor assertor;
+  // The representative depends on the order in which the threads are found
+  assertor.Insert({{"thread-a", "write-a", Event::Type::BEGIN},
+                   {"thread-a", "write-a", Event::Type::END},
+                   {"thread-b", "write-b", Event::Type::BEGIN},
+                   {"thread-b", "write-b", Event::Type::END}},
+                  [&]() { ++calls; });
+  assertor.Insert({{"thread-b", "write-b", Event::Type::BEGIN},
+                   {"thread-b", "write-b", Event::Type::END},
+                   {"thread-a", "write-a", Event::Type::BEGIN},
+                   {"thread-a", "write-a", Event::Type::END}},
+                  [&]() { ++calls; });
+
+  // Writes to different keys commute so all 6 schedules form one trace
+  ReductionReport report = runner.RunAllSchedules(assertor, options);
+  ASSERT_EQ(report.total, 6);
+  ASSERT_EQ(report.explored, 1);
+  ASSERT_EQ(calls, 1);
+}
@@ -0,0 +1,89 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @brief SymbolTable Class Tests
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+
+/**
+ * @brief Enable debug mode if not already enabled
+ *
+ */
+#ifndef __TSTEST_DEBUG__
+#define __TSTEST_DEBUG__
+#endif
+
+#include <tstest/details/symbol_table.hpp>
+
+using namespace tstest::details;
+
+TEST(SymbolTableTest, TestHashSymbol) {
+  // Reference values of the 32-bit FNV-1a hash
+  ASSERT_EQ(HashSymbol("", 0), 2166136261U);
+  ASSERT_EQ(HashSymbol("a", 1), 3826002220U);
+  ASSERT_EQ(HashSymbol("foobar", 6), 0xbf9cf968U);
+}
+
+TEST(SymbolTableTest, TestHashSymbolLiteral) {
+  static_assert(HashSymbol("foobar") == 0xbf9cf968U,
+                "Literal hash must be computed at compile time");
+  ASSERT_EQ(HashSymbol("foobar"), HashSymbol("foobar", 6));
+}
+
+TEST(SymbolTableTest, TestSymbolIdMacro) {
+  SymbolId id = TSTEST_SYMBOL_ID("test-static-symbol");
+
+  ASSERT_EQ(id, HashSymbol("test-static-symbol"));
+  ASSERT_EQ(SymbolTable::Instance().Resolve(id), "test-static-symbol");
+}
+
+TEST(SymbolTableTest, TestIntern) {
+  SymbolTable symbols;
+  SymbolId id = symbols.Intern("test-symbol");
+
+  ASSERT_EQ(id, HashSymbol("test-symbol", 11));
+  ASSERT_EQ(symbols.Intern("test-symbol"), id);
+  ASSERT_EQ(symbols.Size(), 1);
+}
+
+TEST(SymbolTableTest, TestResolve) {
+  SymbolTable symbols;
+  SymbolId id = symbols.Intern("test-symbol");
+
+  ASSERT_EQ(symbols.Resolve(id), "test-symbol");
+  ASSERT_THROW(symbols.Resolve(id + 1), std::out_of_range);
+}
+
+TEST(SymbolTableTest, TestCollision) {
+  SymbolTable symbols;
+  // Known colliding pair for the 32-bit FNV-1a hash
+  ASSERT_EQ(HashSymbol("costarring", 10), HashSymbol("liquid", 6));
+
+  symbols.Intern("costarring");
+  ASSERT_THROW(symbols.Intern("liquid"), SymbolCollision);
+}
+
+TEST(SymbolTableTest, TestConcurrentIntern) {
+  SymbolTable symbols;
+  auto intern = [&]() {
+    for (unsigned int i = 0; i < 100; ++i) {
+      symbols.Intern("symbol-" + std::to_string(i));
+    }
+  };
+  std::thread thread_a(intern);
+  std::thread thread_b(intern);
+  thread_a.join();
+  thread_b.join();
+
+  ASSERT_EQ(symbols.Size(), 100);
+}
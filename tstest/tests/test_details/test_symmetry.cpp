@@ -0,0 +1,65 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @brief Symmetry Groups Tests
+ *
+ */
+
+#include <gtest/gtest.h>
+
+/**
+ * @brief Enable debug mode if not already enabled
+ *
+ */
+#ifndef __TSTEST_DEBUG__
+#define __TSTEST_DEBUG__
+#endif
+
+#include <tstest/details/symmetry.hpp>
+
+using namespace tstest::details;
+
+TEST(SymmetryGroupsTest, TestCanonicalize) {
+  SymmetryGroups symmetry;
+  symmetry.Add({"writer#0", "writer#1"});
+
+  EventList event_list = {{"writer#1", "write", Event::Type::BEGIN},
+                          {"reader", "read", Event::Type::BEGIN},
+                          {"writer#0", "write", Event::Type::BEGIN},
+                          {"writer#1", "write", Event::Type::END}};
+  EventList expected = {{"writer#0", "write", Event::Type::BEGIN},
+                        {"reader", "read", Event::Type::BEGIN},
+                        {"writer#1", "write", Event::Type::BEGIN},
+                        {"writer#0", "write", Event::Type::END}};
+
+  ASSERT_EQ(symmetry.Canonicalize(event_list), expected);
+  ASSERT_FALSE(symmetry.IsCanonical(event_list));
+  ASSERT_TRUE(symmetry.IsCanonical(expected));
+  ASSERT_EQ(symmetry.GetGroup(SymbolTable::Instance().Intern("writer#1")), 0);
+  ASSERT_EQ(symmetry.GetGroup(SymbolTable::Instance().Intern("reader")),
+            static_cast<size_t>(SymmetryGroups::npos));
+}
+
+TEST(SymmetryGroupsTest, TestCanonicalizer) {
+  SymmetryGroups symmetry;
+  symmetry.Add({"writer#0", "writer#1"});
+  SymmetryGroups::Canonicalizer canonicalizer(symmetry);
+
+  ASSERT_EQ(canonicalizer.Next({"writer#1", "write", Event::Type::BEGIN}),
+            Event("writer#0", "write", Event::Type::BEGIN));
+  ASSERT_EQ(canonicalizer.Next({"writer#1", "write", Event::Type::END}),
+            Event("writer#0", "write", Event::Type::END));
+
+  canonicalizer.Reset();
+  ASSERT_EQ(canonicalizer.Next({"writer#1", "write", Event::Type::BEGIN}),
+            Event("writer#0", "write", Event::Type::BEGIN));
+}
+
+TEST(SymmetryGroupsTest, TestReplicaName) {
+  ASSERT_EQ(GetReplicaName("writer", 3), "writer#3");
+}
@@ -0,0 +1,117 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @brief Trace Writer and Reader Tests
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+
+/**
+ * @brief Enable debug mode if not already enabled
+ *
+ */
+#ifndef __TSTEST_DEBUG__
+#define __TSTEST_DEBUG__
+#endif
+
+#include <tstest/details/runner.hpp>
+#include <tstest/details/trace.hpp>
+
+using namespace tstest::details;
+
+class TraceTestFixture : public ::testing::Test {
+ protected:
+  std::string path;
+  void SetUp() override {
+    path = ::testing::TempDir() + "tstest_trace_test.trace";
+  }
+  void TearDown() override { std::remove(path.c_str()); }
+};
+
+TEST_F(TraceTestFixture, TestWriteRead) {
+  EventList event_list;
+  event_list.push_back({"thread-a", "operation-a", Event::Type::BEGIN}, 10);
+  event_list.push_back({"thread-b", "operation-b", Event::Type::BEGIN}, 20);
+  event_list.push_back({"thread-a", "operation-a", Event::Type::END}, 30);
+  {
+    TraceWriter writer(path);
+    writer.Write(event_list);
+    ASSERT_EQ(writer.Size(), 3);
+  }
+
+  TraceReader reader(path);
+
+  ASSERT_TRUE(reader.IsComplete());
+  ASSERT_EQ(reader.Size(), 3);
+  ASSERT_EQ(reader[1], event_list[1]);
+  ASSERT_EQ(reader[1].GetThreadName(), "thread-b");
+  ASSERT_EQ(reader.GetTimestamp(2), 30);
+  ASSERT_EQ(reader.GetEvents(), event_list);
+  ASSERT_EQ(reader.GetEvents().GetTimestamps(), event_list.GetTimestamps());
+  ASSERT_EQ(reader.GetEvents(1, 10), EventList(event_list.begin() + 1,
+                                               event_list.end()));
+}
+
+TEST_F(TraceTestFixture, TestStreamRun) {
+  Runner runner;
+  runner["test-thread-a"] = [&](ExecutionContext context) {
+    context.LogOperationBegin("trace-operation-a");
+    context.LogOperationEnd("trace-operation-a");
+  };
+  runner["test-thread-b"] = [&](ExecutionContext context) {
+    context.LogOperationBegin("trace-operation-b");
+    context.LogOperationEnd("trace-operation-b");
+  };
+  {
+    TraceWriter writer(path);
+    runner.AddListener(&writer);
+    runner.Run();
+    runner.RemoveListener(&writer);
+  }
+
+  TraceReader reader(path);
+  EventList events = reader.GetEvents();
+
+  ASSERT_EQ(events, runner.GetEventLog().View());
+
+  // Traces can be asserted like event logs
+  Assertor assertor;
+  bool asserted = false;
+  assertor.Insert(events, [&]() { asserted = true; });
+  assertor.Assert(reader.GetEvents());
+  ASSERT_TRUE(asserted);
+}
+
+TEST_F(TraceTestFixture, TestIncompleteTrace) {
+  TraceWriter writer(path);
+  writer.Write({"thread-a", "operation-a", Event::Type::BEGIN});
+  writer.Write({"thread-a", "operation-a", Event::Type::END});
+  // Flush the records without finalizing the trace
+  writer.Flush();
+
+  TraceReader reader(path);
+
+  ASSERT_FALSE(reader.IsComplete());
+  ASSERT_EQ(reader.Size(), 2);
+  ASSERT_EQ(reader[1], Event("thread-a", "operation-a", Event::Type::END));
+}
+
+TEST_F(TraceTestFixture, TestInvalidTrace) {
+  ASSERT_THROW(TraceReader(path + ".missing"), TraceError);
+
+  std::FILE *file = std::fopen(path.c_str(), "wb");
+  std::string content(sizeof(TraceHeader), 'x');
+  std::fwrite(content.data(), content.size(), 1, file);
+  std::fclose(file);
+
+  ASSERT_THROW(TraceReader reader(path), TraceError);
+}
@@ -0,0 +1,54 @@
+/**
+ * Copyright (c) 2021 Ketan Goyal
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @brief Worker Pool Class Tests
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+/**
+ * @brief Enable debug mode if not already enabled
+ *
+ */
+#ifndef __TSTEST_DEBUG__
+#define __TSTEST_DEBUG__
+#endif
+
+#include <tstest/details/worker_pool.hpp>
+
+using namespace tstest::details;
+
+TEST(WorkerPoolTest, TestRun) {
+  WorkerPool pool;
+  std::vector<size_t> calls(4, 0);
+
+  for (unsigned int i = 0; i < 100; ++i) {
+    pool.Run(calls.size(), [&](size_t index) { ++calls[index]; });
+  }
+
+  ASSERT_EQ(pool.Size(), 4);
+  ASSERT_EQ(calls, std::vector<size_t>(4, 100));
+}
+
+TEST(WorkerPoolTest, TestGrowAndShrinkRounds) {
+  WorkerPool pool;
+  std::atomic<size_t> count(0);
+  auto task = [&](size_t) { ++count; };
+
+  pool.Run(2, task);
+  pool.Run(5, task);
+  // Workers beyond the count of a round stay parked
+  pool.Run(1, task);
+
+  ASSERT_EQ(pool.Size(), 5);
+  ASSERT_EQ(count.load(), 8);
+}
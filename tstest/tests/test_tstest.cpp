@@ -12,8 +12,10 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <memory>
 #include <string>
+#include <vector>
 
 /**
  * @brief Enable debug mode if not already enabled
@@ -23,6 +25,7 @@
 #define __TSTEST_DEBUG__
 #endif
 
+#include <tstest/details/algorithm.hpp>
 #include <tstest/tstest.hpp>
 
 using namespace tstest;
@@ -55,15 +58,18 @@ TEST_F(TSTestTestFixture, TestEndToEnd) {
     OPERATION("test_operation-b", flag = true);
   };
 
-  // Inserting assertion function for different outcomes
-  assertor->Insert(
+  // Inserting assertion function for different outcomes. The threads are
+  // released together so that any interleaving of their operations may occur.
+  std::vector<tstest::details::EventList> schedules;
+  tstest::details::GetAllSchedules()(
       {
           {"test-thread-b", "test_operation-b", Event::Type::BEGIN},
           {"test-thread-b", "test_operation-b", Event::Type::END},
           {"test-thread-a", "test_operation-a", Event::Type::BEGIN},
           {"test-thread-a", "test_operation-a", Event::Type::END},
       },
-      [&]() { SUCCEED(); });
+      schedules);
+  assertor->InsertMany(schedules, [&]() { SUCCEED(); });
 
   // Running thread functions
   runner->Run();
@@ -71,3 +77,16 @@ TEST_F(TSTestTestFixture, TestEndToEnd) {
   // Assert outcomes
   assertor->Assert(runner->GetEventLog());
 }
+
+TEST_F(TSTestTestFixture, TestReplicatedThreads) {
+  std::atomic<unsigned int> sum(0);
+
+  THREAD_N((*runner), "test-writer", 4) {
+    OPERATION("test_write", sum += context.GetReplicaIndex());
+  };
+
+  runner->Run();
+
+  ASSERT_EQ(sum.load(), 0 + 1 + 2 + 3);
+  ASSERT_EQ(runner->GetEventLog().Size(), 8);
+}